@@ -0,0 +1,101 @@
+/*
+ * BitIntrinsicsBenchmark Example
+ * Compares bitCount, bitClz and bitFindFirst against bit-by-bit loops.
+ * Part of the ArduinoUtilityLib.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <utils.h>
+
+#ifdef __AVR__
+#define BENCH_COUNT 256  // Limited by AVR RAM
+#else
+#define BENCH_COUNT 65536
+#endif
+#define BENCH_ROUNDS 10
+
+// Bit-by-bit reference versions
+uint8_t popcount_loop(uint32_t v) {
+  uint8_t n = 0;
+  while (v) {
+    n += v & 1;
+    v >>= 1;
+  }
+  return n;
+}
+
+uint8_t clz_loop(uint32_t v) {
+  uint8_t n = 0;
+  for (uint32_t m = 0x80000000UL; m && !(v & m); m >>= 1) n++;
+  return n;
+}
+
+size_t find_first_loop(const uint8_t *ar, size_t len) {
+  for (size_t i = 0; i < len * 8; i++) {
+    if (ar[i / 8] & (1 << (i % 8))) return i;
+  }
+  return BIT_NPOS;
+}
+
+void print_time(const char *name, uint32_t us, uint32_t result) {
+  Serial.print(name);
+  Serial.print(us);
+  Serial.print(" us, result ");
+  Serial.println(result);
+}
+
+void setup() {
+  Serial.begin(115200);
+
+  uint32_t *values = (uint32_t *)malloc(BENCH_COUNT * sizeof(uint32_t));
+  if (!values) {
+    Serial.println("Out of memory");
+    return;
+  }
+  for (size_t i = 0; i < BENCH_COUNT; i++) values[i] = (uint32_t)random(0x7FFFFFFFL) >> (i % 31);
+
+  uint32_t sum = 0;
+  uint32_t start = micros();
+  for (uint8_t r = 0; r < BENCH_ROUNDS; r++)
+    for (size_t i = 0; i < BENCH_COUNT; i++) sum += popcount_loop(values[i]);
+  print_time("popcount loop: ", micros() - start, sum);
+
+  sum = 0;
+  start = micros();
+  for (uint8_t r = 0; r < BENCH_ROUNDS; r++)
+    for (size_t i = 0; i < BENCH_COUNT; i++) sum += bitCount(values[i]);
+  print_time("bitCount: ", micros() - start, sum);
+
+  sum = 0;
+  start = micros();
+  for (uint8_t r = 0; r < BENCH_ROUNDS; r++)
+    for (size_t i = 0; i < BENCH_COUNT; i++) sum += clz_loop(values[i]);
+  print_time("clz loop: ", micros() - start, sum);
+
+  sum = 0;
+  start = micros();
+  for (uint8_t r = 0; r < BENCH_ROUNDS; r++)
+    for (size_t i = 0; i < BENCH_COUNT; i++) sum += bitClz(values[i]);
+  print_time("bitClz: ", micros() - start, sum);
+
+  // Sparse bitmap with only its last bit set
+  const uint8_t *bitmap = (const uint8_t *)values;
+  size_t bitmap_len = BENCH_COUNT * sizeof(uint32_t);
+  memset(values, 0, bitmap_len);
+  values[BENCH_COUNT - 1] = 0x80000000UL;
+
+  start = micros();
+  for (uint8_t r = 0; r < BENCH_ROUNDS; r++) sum = find_first_loop(bitmap, bitmap_len);
+  print_time("find first loop: ", micros() - start, sum);
+
+  start = micros();
+  for (uint8_t r = 0; r < BENCH_ROUNDS; r++) sum = bitFindFirst(bitmap, bitmap_len);
+  print_time("bitFindFirst: ", micros() - start, sum);
+
+  free(values);
+}
+
+void loop() {
+  // No periodic tasks needed
+}
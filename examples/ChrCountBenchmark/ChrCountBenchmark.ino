@@ -0,0 +1,69 @@
+/*
+ * ChrCountBenchmark Example
+ * Measures chr_count throughput in GB/s against a byte-at-a-time loop.
+ * Part of the ArduinoUtilityLib.
+ */
+
+#include <stdlib.h>
+#include <utils.h>
+
+#ifdef __AVR__
+#define BENCH_SIZE 1024  // Limited by AVR RAM
+#define BENCH_ROUNDS 10
+#else
+#define BENCH_SIZE (1024UL * 1024UL)
+#define BENCH_ROUNDS 50
+#endif
+
+// Previous chr_count: one compare and one NUL test per byte
+size_t chr_count_bytewise(const char *str, char c) {
+  size_t count = 0;
+  while (*str != '\0') {
+    if (*str++ == c) count++;
+  }
+  return count;
+}
+
+void print_rate(const char *name, uint32_t us, size_t count) {
+  // bytes per microsecond / 1000 = GB/s
+  double gbs = us ? (double)BENCH_SIZE * BENCH_ROUNDS / us / 1000.0 : 0;
+  Serial.print(name);
+  Serial.print(gbs, 3);
+  Serial.print(" GB/s, count ");
+  Serial.println((unsigned long)count);
+}
+
+void setup() {
+  Serial.begin(115200);
+
+  char *buf = (char *)malloc(BENCH_SIZE + 1);
+  if (!buf) {
+    Serial.println("Out of memory");
+    return;
+  }
+
+  // Text with a newline roughly every 40 characters
+  for (size_t i = 0; i < BENCH_SIZE; i++) {
+    buf[i] = (i % 41 == 40) ? '\n' : 'a' + (i % 26);
+  }
+  buf[BENCH_SIZE] = '\0';
+
+  size_t count = 0;
+  uint32_t start = micros();
+  for (uint8_t r = 0; r < BENCH_ROUNDS; r++) count = chr_count_bytewise(buf, '\n');
+  print_rate("Byte loop: ", micros() - start, count);
+
+  start = micros();
+  for (uint8_t r = 0; r < BENCH_ROUNDS; r++) count = chr_count(buf, '\n');
+  print_rate("chr_count: ", micros() - start, count);
+
+  start = micros();
+  for (uint8_t r = 0; r < BENCH_ROUNDS; r++) count = chr_count(buf, BENCH_SIZE, '\n');
+  print_rate("chr_count (bounded): ", micros() - start, count);
+
+  free(buf);
+}
+
+void loop() {
+  // No periodic tasks needed
+}
@@ -0,0 +1,100 @@
+/*
+ * JoinFloatBenchmark Example
+ * Compares join_float against the previous per-element float_to_str implementation,
+ * and checks that join_double rounds exactly like double_to_str.
+ * Part of the ArduinoUtilityLib.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <utils.h>
+
+#ifdef __AVR__
+#define BENCH_COUNT 100  // 10k floats do not fit in AVR RAM
+#else
+#define BENCH_COUNT 10000
+#endif
+#define BENCH_DEC 3
+
+// Previous join_float: one float_to_str (printf/dtostrf) call per element
+char *join_float_legacy(const float *ar, size_t ar_size, char *buf, size_t buf_size, uint8_t dec, char delim) {
+  char *ptr = buf;
+  size_t remaining = buf_size;
+  char temp[32];
+  for (size_t i = 0; i < ar_size; i++) {
+    if (!float_to_str(ar[i], temp, sizeof(temp), 0, dec)) return NULL;
+    size_t temp_len = strlen(temp);
+    bool needs_delimiter = (i < ar_size - 1);
+    if (temp_len + (needs_delimiter ? 1 : 0) + 1 > remaining) return NULL;
+    memcpy(ptr, temp, temp_len);
+    ptr += temp_len;
+    remaining -= temp_len;
+    if (needs_delimiter) {
+      *ptr++ = delim;
+      remaining--;
+    }
+  }
+  *ptr = '\0';
+  return buf;
+}
+
+void setup() {
+  Serial.begin(115200);
+
+  size_t buf_size = BENCH_COUNT * FLOAT_CHR_MAX;
+  float *values = (float *)malloc(BENCH_COUNT * sizeof(float));
+  char *buf_legacy = (char *)malloc(buf_size);
+  char *buf_batch = (char *)malloc(buf_size);
+  if (!values || !buf_legacy || !buf_batch) {
+    Serial.println("Out of memory");
+    return;
+  }
+
+  // Sensor-like values: mixed sign and magnitude
+  for (size_t i = 0; i < BENCH_COUNT; i++) {
+    values[i] = (float)((int32_t)(i * 7919UL % 200001UL) - 100000) / 37.0f;
+  }
+
+  uint32_t start = micros();
+  join_float_legacy(values, BENCH_COUNT, buf_legacy, buf_size, BENCH_DEC, ',');
+  uint32_t legacy_us = micros() - start;
+
+  start = micros();
+  join_float(values, BENCH_COUNT, buf_batch, buf_size, BENCH_DEC, ',');
+  uint32_t batch_us = micros() - start;
+
+  Serial.print("Elements: ");
+  Serial.println(BENCH_COUNT);
+  Serial.print("float_to_str loop (us): ");
+  Serial.println(legacy_us);
+  Serial.print("join_float (us): ");
+  Serial.println(batch_us);
+  Serial.print("Output identical: ");
+  Serial.println(strcmp(buf_legacy, buf_batch) == 0 ? "yes" : "no");
+
+  // Multiples of 1/16 land exactly halfway between two 3-decimal results, the
+  // case where a naive "+ 0.5" rounding disagrees with double_to_str
+  double *halves = (double *)values;
+  size_t half_count = BENCH_COUNT * sizeof(float) / sizeof(double);
+  for (size_t i = 0; i < half_count; i++) {
+    halves[i] = ((double)i - half_count / 2) / 16.0;
+  }
+  join_double(halves, half_count, buf_batch, buf_size, BENCH_DEC, ',');
+  char *ptr = buf_legacy;
+  for (size_t i = 0; i < half_count; i++) {
+    double_to_str(halves[i], ptr, DOUBLE_CHR_MAX, 0, BENCH_DEC);
+    ptr += strlen(ptr);
+    if (i < half_count - 1) *ptr++ = ',';
+  }
+  *ptr = '\0';
+  Serial.print("join_double matches double_to_str: ");
+  Serial.println(strcmp(buf_legacy, buf_batch) == 0 ? "yes" : "no");
+
+  free(values);
+  free(buf_legacy);
+  free(buf_batch);
+}
+
+void loop() {
+  // No periodic tasks needed
+}
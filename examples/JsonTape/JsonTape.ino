@@ -0,0 +1,56 @@
+/*
+ * JsonTape Example
+ * Demonstrates indexing a JSON message once with json_index and reading fields from the tape.
+ * Part of the ArduinoUtilityLib.
+ */
+
+#include <utils.h>
+
+void setup() {
+  Serial.begin(9600);
+
+  const char *msg = "{\"cfg\":{\"rate\":115200,\"name\":\"node-1\"},\"values\":[10,20,30,40]}";
+
+  // Index the message in a single pass
+  json_tok tape[JSON_TAPE_MAX];
+  size_t count = json_index(msg, tape, JSON_TAPE_MAX);
+  if (count == 0) {
+    Serial.println("Malformed JSON");
+    return;
+  }
+
+  // cfg.rate; lookups chain safely, a missing parent yields JSON_NPOS
+  size_t cfg = json_key(msg, tape, count, 0, "cfg");
+  size_t rate = json_key(msg, tape, count, cfg, "rate");
+  if (rate != JSON_NPOS) {
+    Serial.print("cfg.rate: ");
+    Serial.println(str_to_i32(json_str(msg, &tape[rate])));  // Prints 115200
+  }
+
+  // cfg.name, read in place without copying
+  size_t name_tok = json_key(msg, tape, count, cfg, "name");
+  if (name_tok != JSON_NPOS) {
+    size_t len;
+    const char *name = json_str(msg, &tape[name_tok], &len);
+    Serial.print("cfg.name: ");
+    for (size_t i = 0; i < len; i++) Serial.print(name[i]);
+    Serial.println();  // Prints node-1
+  }
+
+  // values[3]
+  size_t values = json_key(msg, tape, count, 0, "values");
+  size_t v3 = json_at(tape, count, values, 3);
+  if (v3 != JSON_NPOS) {
+    Serial.print("values[3]: ");
+    Serial.println(str_to_i32(json_str(msg, &tape[v3])));  // Prints 40
+  }
+
+  // A missing key is reported instead of indexing the tape with JSON_NPOS
+  if (json_key(msg, tape, count, json_key(msg, tape, count, 0, "missing"), "rate") == JSON_NPOS) {
+    Serial.println("missing.rate: not found");
+  }
+}
+
+void loop() {
+  // No periodic tasks needed
+}
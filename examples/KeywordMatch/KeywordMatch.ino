@@ -0,0 +1,63 @@
+/*
+ * KeywordMatch Example
+ * Demonstrates counting several keywords in one pass with ac_build and ac_scan,
+ * and printing the automaton so it can be stored in flash (PROGMEM) on AVR.
+ * Part of the ArduinoUtilityLib.
+ */
+
+#include <string.h>
+#include <utils.h>
+
+const char *const keywords[] = {"ERROR", "WARN", "OK", "+CREG:"};
+#define KEYWORD_COUNT 4
+
+ac_node nodes[32];
+ac_matcher matcher;
+
+void setup() {
+  Serial.begin(9600);
+
+  if (!ac_build(&matcher, nodes, 32, keywords, KEYWORD_COUNT)) {
+    Serial.println("Node table too small");
+    return;
+  }
+
+  const char *log = "OK\r\n+CREG: 0,1\r\nWARN low signal\r\nERROR\r\nOK\r\n";
+  size_t counts[KEYWORD_COUNT];
+  size_t first[KEYWORD_COUNT];
+  ac_scan(&matcher, log, strlen(log), counts, first);
+
+  for (uint8_t k = 0; k < KEYWORD_COUNT; k++) {
+    Serial.print(keywords[k]);
+    Serial.print(": count ");
+    Serial.print((unsigned long)counts[k]);
+    Serial.print(", first at ");
+    Serial.println((long)first[k]);
+  }
+
+  // Paste this output into a sketch as "const ac_node table[] PROGMEM = {...};"
+  // and use ac_attach_P(&matcher, table, count, KEYWORD_COUNT) to keep it in flash.
+  Serial.println("Node table:");
+  for (uint16_t i = 0; i < matcher.count; i++) {
+    const ac_node &n = nodes[i];
+    Serial.print("  {");
+    Serial.print((int)n.ch);
+    Serial.print(", ");
+    Serial.print(n.depth);
+    Serial.print(", ");
+    Serial.print(n.out);
+    Serial.print(", ");
+    Serial.print(n.child);
+    Serial.print(", ");
+    Serial.print(n.next);
+    Serial.print(", ");
+    Serial.print(n.fail);
+    Serial.print(", ");
+    Serial.print(n.dict);
+    Serial.println("},");
+  }
+}
+
+void loop() {
+  // No periodic tasks needed
+}
@@ -9,12 +9,909 @@
 #include <Arduino.h>
 #endif
 
+#ifdef __AVR__
+#include <avr/pgmspace.h>
+#endif
+
+#if defined(__SSE2__) || defined(__PCLMUL__)
+#include <immintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// Word-at-a-time (SWAR) helpers: a swar_t holds sizeof(swar_t) bytes that are
+// tested in parallel. swar_zero() flags (with 0x80) every zero byte of v; flags
+// above the first zero byte may be false positives, the lowest one is exact.
+// AVR pointers are 16 bits, so it gets a 32-bit word to still cover 4 bytes.
+#ifdef __AVR__
+typedef uint32_t swar_t;
+#else
+typedef uintptr_t swar_t;
+#endif
+#define SWAR_ONES ((swar_t)-1 / 0xFF)
+#define SWAR_HIGHS (SWAR_ONES * 0x80)
+
+static inline swar_t swar_load(const char *p) {
+  swar_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+static inline swar_t swar_zero(swar_t v) {
+  return (v - SWAR_ONES) & ~v & SWAR_HIGHS;
+}
+
+static inline swar_t swar_eq(swar_t v, char c) {
+  return swar_zero(v ^ (SWAR_ONES * (uint8_t)c));
+}
+
+// Non-zero if any byte of v is not an ASCII digit. Carry-free: after the XOR a
+// digit byte is 0x00-0x09, and adding 6 to a low nibble cannot leave the byte.
+static inline swar_t swar_nondigit(swar_t v) {
+  swar_t x = v ^ (SWAR_ONES * 0x30);
+  return (x & (SWAR_ONES * 0xF0)) | (((x & (SWAR_ONES * 0x0F)) + SWAR_ONES * 0x06) & (SWAR_ONES * 0x10));
+}
+
+size_t bitCount(const uint8_t *ar, size_t len) {
+  if (!ar) return 0;
+  size_t count = 0;
+  size_t i = 0;
+#ifndef __AVR__
+  for (; i + sizeof(uint64_t) <= len; i += sizeof(uint64_t)) {
+    uint64_t w;
+    memcpy(&w, ar + i, sizeof(w));
+    count += bitCount(w);
+  }
+#endif
+  for (; i < len; i++) count += bitCount(ar[i]);
+  return count;
+}
+
+size_t bitFindNext(const uint8_t *ar, size_t len, size_t from) {
+  if (!ar) return BIT_NPOS;
+  size_t i = from / 8;
+  if (i >= len) return BIT_NPOS;
+
+  // Rest of the first byte
+  uint8_t b = ar[i] & (uint8_t)(0xFF << (from & 7));
+  if (b) return i * 8 + bitCtz(b);
+  i++;
+
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  // Zero words are skipped whole; a little-endian load numbers bits the same way
+  for (; i + sizeof(swar_t) <= len; i += sizeof(swar_t)) {
+    swar_t w = swar_load((const char *)ar + i);
+    if (w) return i * 8 + bitCtz(w);
+  }
+#endif
+  for (; i < len; i++) {
+    if (ar[i]) return i * 8 + bitCtz(ar[i]);
+  }
+  return BIT_NPOS;
+}
+
+size_t bitFindFirst(const uint8_t *ar, size_t len) {
+  return bitFindNext(ar, len, 0);
+}
+
+// Reverses the bytes of each U in [src, src + count); dst may equal src. Large
+// arrays are shuffled 16 bytes at a time.
+template <typename U>
+static void swap_arr(void *dst, const void *src, size_t count) {
+  uint8_t *d = (uint8_t *)dst;
+  const uint8_t *s = (const uint8_t *)src;
+  size_t bytes = count * sizeof(U);
+  size_t i = 0;
+#if defined(__SSSE3__)
+  const __m128i shuf = sizeof(U) == 2   ? _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14)
+                       : sizeof(U) == 4 ? _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12)
+                                        : _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+  for (; i + 16 <= bytes; i += 16) {
+    _mm_storeu_si128((__m128i *)(d + i), _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(s + i)), shuf));
+  }
+#elif defined(__ARM_NEON)
+  for (; i + 16 <= bytes; i += 16) {
+    uint8x16_t v = vld1q_u8(s + i);
+    v = sizeof(U) == 2 ? vrev16q_u8(v) : sizeof(U) == 4 ? vrev32q_u8(v) : vrev64q_u8(v);
+    vst1q_u8(d + i, v);
+  }
+#endif
+  for (; i < bytes; i += sizeof(U)) {
+    U v;
+    memcpy(&v, s + i, sizeof(v));
+    v = byteSwap(v);
+    memcpy(d + i, &v, sizeof(v));
+  }
+}
+
+// Copies count values of U, swapping them if the wire order is not native
+template <typename U>
+static void endian_copy(void *dst, const void *src, size_t count, bool big) {
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  bool swap = big;
+#else
+  bool swap = !big;
+#endif
+  if (swap) {
+    swap_arr<U>(dst, src, count);
+  } else if (dst != src) {
+    memmove(dst, src, count * sizeof(U));
+  }
+}
+
+void *swap16_arr(void *dst, const void *src, size_t count) {
+  if (!dst || !src) return NULL;
+  swap_arr<uint16_t>(dst, src, count);
+  return dst;
+}
+
+void *swap32_arr(void *dst, const void *src, size_t count) {
+  if (!dst || !src) return NULL;
+  swap_arr<uint32_t>(dst, src, count);
+  return dst;
+}
+
+void *swap64_arr(void *dst, const void *src, size_t count) {
+  if (!dst || !src) return NULL;
+  swap_arr<uint64_t>(dst, src, count);
+  return dst;
+}
+
+void *load_be16_arr(void *dst, const uint8_t *src, size_t count) {
+  if (!dst || !src) return NULL;
+  endian_copy<uint16_t>(dst, src, count, true);
+  return dst;
+}
+
+void *load_be32_arr(void *dst, const uint8_t *src, size_t count) {
+  if (!dst || !src) return NULL;
+  endian_copy<uint32_t>(dst, src, count, true);
+  return dst;
+}
+
+void *load_be64_arr(void *dst, const uint8_t *src, size_t count) {
+  if (!dst || !src) return NULL;
+  endian_copy<uint64_t>(dst, src, count, true);
+  return dst;
+}
+
+void *load_le16_arr(void *dst, const uint8_t *src, size_t count) {
+  if (!dst || !src) return NULL;
+  endian_copy<uint16_t>(dst, src, count, false);
+  return dst;
+}
+
+void *load_le32_arr(void *dst, const uint8_t *src, size_t count) {
+  if (!dst || !src) return NULL;
+  endian_copy<uint32_t>(dst, src, count, false);
+  return dst;
+}
+
+void *load_le64_arr(void *dst, const uint8_t *src, size_t count) {
+  if (!dst || !src) return NULL;
+  endian_copy<uint64_t>(dst, src, count, false);
+  return dst;
+}
+
+uint8_t *store_be16_arr(uint8_t *dst, const void *src, size_t count) {
+  if (!dst || !src) return NULL;
+  endian_copy<uint16_t>(dst, src, count, true);
+  return dst;
+}
+
+uint8_t *store_be32_arr(uint8_t *dst, const void *src, size_t count) {
+  if (!dst || !src) return NULL;
+  endian_copy<uint32_t>(dst, src, count, true);
+  return dst;
+}
+
+uint8_t *store_be64_arr(uint8_t *dst, const void *src, size_t count) {
+  if (!dst || !src) return NULL;
+  endian_copy<uint64_t>(dst, src, count, true);
+  return dst;
+}
+
+uint8_t *store_le16_arr(uint8_t *dst, const void *src, size_t count) {
+  if (!dst || !src) return NULL;
+  endian_copy<uint16_t>(dst, src, count, false);
+  return dst;
+}
+
+uint8_t *store_le32_arr(uint8_t *dst, const void *src, size_t count) {
+  if (!dst || !src) return NULL;
+  endian_copy<uint32_t>(dst, src, count, false);
+  return dst;
+}
+
+uint8_t *store_le64_arr(uint8_t *dst, const void *src, size_t count) {
+  if (!dst || !src) return NULL;
+  endian_copy<uint64_t>(dst, src, count, false);
+  return dst;
+}
+
+// Packed BCD is converted in every byte of a word at once (4 bytes on AVR, 8 on
+// 64-bit hosts). A BCD byte 16h + l becomes 10h + l by subtracting 6h; a binary
+// byte x becomes BCD by adding 6 * (x / 10), with x / 10 == (x * 205) >> 11 for
+// every byte value, so no division is needed. The products need 16 bits, so odd
+// and even bytes are handled in separate 16-bit lanes, and each lane is cut back
+// to 8 bits: bytes above 99 wrap exactly like the scalar form and never carry
+// into their neighbour.
+#define BCD_LANES ((swar_t)-1 / 0xFFFF)
+
+static inline swar_t bcd_word_dec(swar_t v) {
+  return v - ((v >> 4) & (SWAR_ONES * 0x0F)) * 6;
+}
+
+static inline swar_t bcd_lane(swar_t x) {
+  swar_t q = ((x * 205) >> 11) & (BCD_LANES * 0x001F);
+  return (x + q * 6) & (BCD_LANES * 0x00FF);
+}
+
+static inline swar_t dec_word_bcd(swar_t v) {
+  const swar_t lane = BCD_LANES * 0x00FF;
+  return bcd_lane(v & lane) | (bcd_lane((v >> 8) & lane) << 8);
+}
+
 uint8_t bcd2dec(uint8_t bcd) {
-  return (((bcd >> 4) & 0xf) * 10) + (bcd & 0xf);
+  return (uint8_t)bcd_word_dec(bcd);
 }
 
 uint8_t dec2bcd(uint8_t dec) {
-  return (((dec / 10) << 4) & 0xf0) + (dec % 10);
+  return (uint8_t)dec_word_bcd(dec);
+}
+
+uint8_t *bcd2dec(const uint8_t *bcd, uint8_t *dec, size_t len) {
+  if (!bcd || !dec) return NULL;
+  size_t i = 0;
+  for (; i + sizeof(swar_t) <= len; i += sizeof(swar_t)) {
+    swar_t v = bcd_word_dec(swar_load((const char *)bcd + i));
+    memcpy(dec + i, &v, sizeof(v));
+  }
+  for (; i < len; i++) dec[i] = bcd2dec(bcd[i]);
+  return dec;
+}
+
+uint8_t *dec2bcd(const uint8_t *dec, uint8_t *bcd, size_t len) {
+  if (!dec || !bcd) return NULL;
+  size_t i = 0;
+  for (; i + sizeof(swar_t) <= len; i += sizeof(swar_t)) {
+    swar_t v = dec_word_bcd(swar_load((const char *)dec + i));
+    memcpy(bcd + i, &v, sizeof(v));
+  }
+  for (; i < len; i++) bcd[i] = dec2bcd(dec[i]);
+  return bcd;
+}
+
+// Packed BCD counters: digit pairs are combined in place, then pairs of pairs,
+// so an 8-digit value needs three multiply steps instead of eight.
+uint32_t bcd32_to_u32(uint32_t bcd) {
+  bcd = (bcd & 0x0F0F0F0F) + ((bcd >> 4) & 0x0F0F0F0F) * 10;
+  bcd = (bcd & 0x00FF00FF) + ((bcd >> 8) & 0x00FF00FF) * 100;
+  return (bcd & 0xFFFF) + (bcd >> 16) * 10000;
+}
+
+uint64_t bcd64_to_u64(uint64_t bcd) {
+  bcd = (bcd & 0x0F0F0F0F0F0F0F0FULL) + ((bcd >> 4) & 0x0F0F0F0F0F0F0F0FULL) * 10;
+  bcd = (bcd & 0x00FF00FF00FF00FFULL) + ((bcd >> 8) & 0x00FF00FF00FF00FFULL) * 100;
+  bcd = (bcd & 0x0000FFFF0000FFFFULL) + ((bcd >> 16) & 0x0000FFFF0000FFFFULL) * 10000;
+  return (bcd & 0xFFFFFFFF) + (bcd >> 32) * 100000000ULL;
+}
+
+uint32_t u32_to_bcd32(uint32_t num) {
+  if (num > 99999999UL) num %= 100000000UL;
+#ifdef __AVR__
+  // Double dabble: no division, and only 32-bit adds and shifts. Before each
+  // input bit is shifted in, 3 is added to every digit of 5 or more.
+  uint32_t bcd = 0;
+  num <<= 5;  // 99999999 fits in 27 bits
+  for (uint8_t i = 0; i < 27; i++) {
+    bcd += (((bcd + 0x33333333UL) & 0x88888888UL) >> 3) * 3;
+    bcd = (bcd << 1) | (num >> 31);
+    num <<= 1;
+  }
+  return bcd;
+#else
+  // Split into two 4-digit halves in 32-bit lanes, then divide each lane by 100
+  // and each 16-bit lane by 10 with reciprocal multiplications
+  uint32_t hi = num / 10000;
+  uint64_t v = ((uint64_t)hi << 32) | (num - hi * 10000);
+  uint64_t q = ((v * 5243) >> 19) & 0x0000007F0000007FULL;  // n / 100 for n < 43699
+  v = (q << 16) | (v - q * 100);
+  q = ((v * 103) >> 10) & 0x000F000F000F000FULL;  // n / 10 for n < 179
+  v = (q << 8) | (v - q * 10);
+  // One digit per byte, most significant first; pack to nibbles
+  v = (v | (v >> 4)) & 0x00FF00FF00FF00FFULL;
+  v = (v | (v >> 8)) & 0x0000FFFF0000FFFFULL;
+  return (uint32_t)(v | (v >> 16));
+#endif
+}
+
+uint64_t u64_to_bcd64(uint64_t num) {
+  if (num > 9999999999999999ULL) num %= 10000000000000000ULL;
+  uint32_t hi = (uint32_t)(num / 100000000ULL);
+  uint32_t lo = (uint32_t)(num - (uint64_t)hi * 100000000ULL);
+  return ((uint64_t)u32_to_bcd32(hi) << 32) | u32_to_bcd32(lo);
+}
+
+// Non-zero if any nibble of a 32-bit BCD value is above 9
+static inline uint32_t bcd32_invalid(uint32_t bcd) {
+  return ((((bcd & 0x0F0F0F0F) + 0x06060606) | (((bcd >> 4) & 0x0F0F0F0F) + 0x06060606)) & 0x10101010);
+}
+
+// Writes the digits of a BCD value held in the top bits of bcd, skipping
+// leading zeros. Shifting by 4 each step avoids variable shifts on AVR.
+template <typename T>
+static char *bcd_to_str(T bcd, char *str, uint8_t str_len) {
+  if (!str || str_len < 2) return NULL;
+  const uint8_t top = sizeof(T) * 8 - 4;
+  uint8_t n = sizeof(T) * 2;
+  while (n > 1 && (bcd >> top) == 0) {
+    bcd <<= 4;
+    n--;
+  }
+  if (n >= str_len) return NULL;  // Buffer too small
+  for (uint8_t i = 0; i < n; i++) {
+    str[i] = '0' + (char)(bcd >> top);
+    bcd <<= 4;
+  }
+  str[n] = '\0';
+  return str;
+}
+
+char *bcd32_to_str(uint32_t bcd, char *str, uint8_t str_len) {
+  if (bcd32_invalid(bcd)) return NULL;
+  return bcd_to_str(bcd, str, str_len);
+}
+
+char *bcd64_to_str(uint64_t bcd, char *str, uint8_t str_len) {
+  if (bcd32_invalid((uint32_t)bcd) || bcd32_invalid((uint32_t)(bcd >> 32))) return NULL;
+  return bcd_to_str(bcd, str, str_len);
+}
+
+// Bit streams keep up to a cache word of bits. MSB-first streams keep the next
+// bit at the top of the cache, LSB-first streams at the bottom. On hosts the
+// cache is refilled and drained a whole word at a time; the bits past `bits`
+// may then already hold the following input bytes, which a later refill writes
+// again unchanged. BIT_CHUNK is the widest field one cache step handles.
+#define BIT_CACHE_W (sizeof(bit_cache_t) * 8)
+#ifdef __AVR__
+#define BIT_CHUNK 24
+#else
+#define BIT_CHUNK 32
+
+static inline bit_cache_t bit_word_load(const uint8_t *p, bool lsb) {
+  bit_cache_t w;
+  memcpy(&w, p, sizeof(w));
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+  return lsb ? w : __builtin_bswap64(w);
+#else
+  return lsb ? __builtin_bswap64(w) : w;
+#endif
+}
+
+static inline void bit_word_store(uint8_t *p, bit_cache_t w, bool lsb) {
+  w = bit_word_load((const uint8_t *)&w, lsb);  // The swap is its own inverse
+  memcpy(p, &w, sizeof(w));
+}
+#endif
+
+void bit_reader_init(bit_reader *br, const uint8_t *buf, size_t len, bool lsb_first) {
+  if (!br) return;
+  br->buf = buf;
+  br->len = buf ? len : 0;
+  br->pos = 0;
+  br->cache = 0;
+  br->bits = 0;
+  br->lsb = lsb_first;
+  br->error = false;
+}
+
+static void bit_refill(bit_reader *br) {
+#ifndef __AVR__
+  if (br->pos + sizeof(bit_cache_t) <= br->len) {
+    bit_cache_t w = bit_word_load(br->buf + br->pos, br->lsb);
+    uint8_t take = (BIT_CACHE_W - br->bits) >> 3;
+    br->cache |= br->lsb ? w << br->bits : w >> br->bits;
+    br->pos += take;
+    br->bits += take * 8;
+    return;
+  }
+#endif
+  while (br->bits <= BIT_CACHE_W - 8 && br->pos < br->len) {
+    bit_cache_t b = br->buf[br->pos++];
+    br->cache |= br->lsb ? b << br->bits : b << (BIT_CACHE_W - 8 - br->bits);
+    br->bits += 8;
+  }
+}
+
+// Reads n (1..BIT_CHUNK) bits; consume == false leaves them in the cache
+static uint32_t bit_take(bit_reader *br, uint8_t n, bool consume) {
+  if (br->bits < n) {
+    bit_refill(br);
+    if (br->bits < n) {
+      // Past the end: the missing bits read as 0
+      br->error = true;
+      if (consume) br->bits = n;
+    }
+  }
+  uint32_t v;
+  if (br->lsb) {
+    v = (uint32_t)(br->cache & bitMask<bit_cache_t>(n));
+    if (consume) br->cache >>= n;
+  } else {
+    v = (uint32_t)(br->cache >> (BIT_CACHE_W - n));
+    if (consume) br->cache <<= n;
+  }
+  if (consume) br->bits -= n;
+  return v;
+}
+
+uint32_t bit_read(bit_reader *br, uint8_t n) {
+  if (!br || n == 0 || n > 32) return 0;
+  if (n <= BIT_CHUNK) return bit_take(br, n, true);
+  // Wider than one cache step (AVR): two reads
+  if (br->lsb) {
+    uint32_t lo = bit_take(br, 16, true);
+    return lo | (bit_take(br, n - 16, true) << 16);
+  }
+  uint32_t hi = bit_take(br, n - 16, true);
+  return (hi << 16) | bit_take(br, 16, true);
+}
+
+uint32_t bit_peek(bit_reader *br, uint8_t n) {
+  if (!br || n == 0 || n > BIT_CHUNK) return 0;
+  bool error = br->error;
+  uint32_t v = bit_take(br, n, false);
+  br->error = error;  // Peeking past the end is not an error
+  return v;
+}
+
+void bit_skip(bit_reader *br, size_t n) {
+  if (!br) return;
+  if (n > br->bits) {
+    // Drop the cache and move the byte position
+    n -= br->bits;
+    br->bits = 0;
+    br->cache = 0;
+    if (n / 8 > br->len - br->pos) {
+      br->pos = br->len;
+      br->error = true;
+      return;
+    }
+    br->pos += n / 8;
+    n &= 7;
+  }
+  for (; n > BIT_CHUNK; n -= BIT_CHUNK) bit_take(br, BIT_CHUNK, true);
+  if (n) bit_take(br, (uint8_t)n, true);
+}
+
+void bit_align(bit_reader *br) {
+  if (br && (br->bits & 7)) bit_take(br, br->bits & 7, true);
+}
+
+size_t bit_tell(const bit_reader *br) {
+  return br ? br->pos * 8 - br->bits : 0;
+}
+
+size_t bit_read_bytes(bit_reader *br, uint8_t *dst, size_t n) {
+  if (!br || !dst) return 0;
+  size_t i = 0;
+  if (br->bits & 7) {
+    // Not byte aligned: every byte straddles two input bytes
+    for (; i < n; i++) {
+      uint8_t b = (uint8_t)bit_take(br, 8, true);
+      if (br->error) break;
+      dst[i] = b;
+    }
+    return i;
+  }
+  // Byte aligned: empty the cache, then copy straight from the buffer
+  for (; i < n && br->bits; i++) dst[i] = (uint8_t)bit_take(br, 8, true);
+  if (i == n) return n;
+  br->cache = 0;
+  size_t copy = n - i;
+  if (copy > br->len - br->pos) {
+    copy = br->len - br->pos;
+    br->error = true;
+  }
+  memcpy(dst + i, br->buf + br->pos, copy);
+  br->pos += copy;
+  return i + copy;
+}
+
+void bit_writer_init(bit_writer *bw, uint8_t *buf, size_t size, bool lsb_first) {
+  if (!bw) return;
+  bw->buf = buf;
+  bw->size = buf ? size : 0;
+  bw->pos = 0;
+  bw->cache = 0;
+  bw->bits = 0;
+  bw->lsb = lsb_first;
+  bw->error = false;
+}
+
+// Moves the whole bytes of the cache to the buffer
+static void bit_drain(bit_writer *bw) {
+#ifndef __AVR__
+  if (bw->pos + sizeof(bit_cache_t) <= bw->size) {
+    // Store the full word; the bytes past the whole ones are written again later
+    bit_word_store(bw->buf + bw->pos, bw->cache, bw->lsb);
+    uint8_t bytes = bw->bits >> 3;
+    bw->pos += bytes;
+    if (bytes == sizeof(bit_cache_t)) {
+      bw->cache = 0;
+    } else if (bytes) {
+      if (bw->lsb) {
+        bw->cache >>= bytes * 8;
+      } else {
+        bw->cache <<= bytes * 8;
+      }
+    }
+    bw->bits &= 7;
+    return;
+  }
+#endif
+  while (bw->bits >= 8) {
+    if (bw->pos == bw->size) {
+      bw->error = true;
+      return;
+    }
+    if (bw->lsb) {
+      bw->buf[bw->pos++] = (uint8_t)bw->cache;
+      bw->cache >>= 8;
+    } else {
+      bw->buf[bw->pos++] = (uint8_t)(bw->cache >> (BIT_CACHE_W - 8));
+      bw->cache <<= 8;
+    }
+    bw->bits -= 8;
+  }
+}
+
+// Whether n more bits fit in the buffer, counting the bits still in the cache
+static inline bool bit_fits(const bit_writer *bw, size_t n) {
+  return n <= (bw->size - bw->pos) * 8 - bw->bits;
+}
+
+static void bit_put(bit_writer *bw, uint32_t v, uint8_t n) {
+  if (bw->error || !bit_fits(bw, n)) {
+    bw->error = true;
+    return;
+  }
+  if (bw->bits + n > BIT_CACHE_W) bit_drain(bw);
+  bit_cache_t f = (bit_cache_t)v & bitMask<bit_cache_t>(n);
+  if (bw->lsb) {
+    bw->cache |= f << bw->bits;
+  } else {
+    bw->cache |= f << (BIT_CACHE_W - bw->bits - n);
+  }
+  bw->bits += n;
+}
+
+bool bit_write(bit_writer *bw, uint32_t v, uint8_t n) {
+  if (!bw || n > 32) return false;
+  if (n == 0) return !bw->error;
+  if (!bit_fits(bw, n)) {
+    // Refuse the whole field rather than write part of it
+    bw->error = true;
+    return false;
+  }
+  if (n <= BIT_CHUNK) {
+    bit_put(bw, v, n);
+  } else if (bw->lsb) {
+    bit_put(bw, v, 16);
+    bit_put(bw, v >> 16, n - 16);
+  } else {
+    bit_put(bw, v >> 16, n - 16);
+    bit_put(bw, v, 16);
+  }
+  return !bw->error;
+}
+
+bool bit_write_bytes(bit_writer *bw, const uint8_t *src, size_t n) {
+  if (!bw || !src) return false;
+  if (bw->bits & 7) {
+    if (n > ((bw->size - bw->pos) * 8 - bw->bits) / 8) {
+      bw->error = true;
+      return false;
+    }
+    for (size_t i = 0; i < n && !bw->error; i++) bit_put(bw, src[i], 8);
+    return !bw->error;
+  }
+  // Byte aligned: empty the cache, then copy straight to the buffer
+  while (bw->bits && !bw->error) {
+    size_t pos = bw->pos;
+    bit_drain(bw);
+    if (bw->pos == pos) break;
+  }
+  if (bw->error) return false;
+  if (n > bw->size - bw->pos) {
+    bw->error = true;
+    return false;
+  }
+  memcpy(bw->buf + bw->pos, src, n);
+  bw->pos += n;
+  return true;
+}
+
+size_t bit_flush(bit_writer *bw) {
+  if (!bw) return 0;
+  bit_drain(bw);
+  if (bw->bits && !bw->error) {
+    // Pad the last byte with zeros
+    if (bw->pos == bw->size) {
+      bw->error = true;
+    } else {
+      bw->buf[bw->pos++] = (uint8_t)(bw->lsb ? bw->cache : bw->cache >> (BIT_CACHE_W - 8));
+    }
+  }
+  bw->cache = 0;
+  bw->bits = 0;
+  return bw->error ? 0 : bw->pos;
+}
+
+// Gorilla XOR streams, MSB-first: the first value raw, then per value '0' when
+// it repeats, '10' + the XOR bits inside the previous window, or '11' + 5-bit
+// leading zero count + (length - 1) in 5 (float) or 6 (double) bits + the XOR
+// bits. A window that does not fit in the value width marks the end.
+#define XOR_LEAD_BITS 5
+#define XOR_LEAD_MAX 31
+
+static inline uint8_t xor_len_bits(bool wide) {
+  return wide ? 6 : 5;
+}
+
+template <typename U>
+static bool xor_put(bit_writer *bw, U v, uint8_t n) {
+  if (n > 32) {
+    bit_write(bw, (uint32_t)((uint64_t)v >> 32), n - 32);
+    n = 32;
+  }
+  return bit_write(bw, (uint32_t)v, n);
+}
+
+template <typename U>
+static U xor_get(bit_reader *br, uint8_t n) {
+  U v = 0;
+  if (n > 32) {
+    v = (U)((uint64_t)bit_read(br, n - 32) << 32);
+    n = 32;
+  }
+  return v | (U)bit_read(br, n);
+}
+
+template <typename U>
+static bool xor_encode(xor_encoder *enc, U v, U *prev) {
+  const uint8_t w = sizeof(U) * 8;
+  const uint8_t header = 2 + XOR_LEAD_BITS + xor_len_bits(enc->wide);
+  bit_writer *bw = &enc->bw;
+  // Refuse a value unless its worst case and the end marker both fit, so the
+  // values accepted so far can always be finished
+  if (!bit_fits(bw, (enc->count ? header + w : w) + header)) return false;
+  if (enc->count == 0) {
+    xor_put(bw, v, w);
+  } else {
+    U x = v ^ *prev;
+    if (x == 0) {
+      bit_write(bw, 0, 1);
+    } else {
+      uint8_t lead = bitClz(x);
+      uint8_t trail = bitCtz(x);
+      if (lead > XOR_LEAD_MAX) lead = XOR_LEAD_MAX;
+      if (enc->len && lead >= enc->lead && trail >= w - enc->lead - enc->len) {
+        // Fits the previous window: no need to send its position
+        bit_write(bw, 2, 2);
+        xor_put(bw, (U)(x >> (w - enc->lead - enc->len)), enc->len);
+      } else {
+        enc->lead = lead;
+        enc->len = w - lead - trail;
+        bit_write(bw, 3, 2);
+        bit_write(bw, lead, XOR_LEAD_BITS);
+        bit_write(bw, enc->len - 1, xor_len_bits(enc->wide));
+        xor_put(bw, (U)(x >> trail), enc->len);
+      }
+    }
+  }
+  *prev = v;
+  enc->count++;
+  return true;
+}
+
+template <typename U>
+static bool xor_decode(xor_decoder *dec, U *prev) {
+  const uint8_t w = sizeof(U) * 8;
+  bit_reader *br = &dec->br;
+  if (dec->end) return false;
+  if (dec->count == 0) {
+    U v = xor_get<U>(br, w);
+    if (br->error) return false;
+    *prev = v;
+    dec->count++;
+    return true;
+  }
+  if (bit_read(br, 1)) {
+    if (bit_read(br, 1)) {
+      uint8_t lead = (uint8_t)bit_read(br, XOR_LEAD_BITS);
+      uint8_t len = (uint8_t)bit_read(br, xor_len_bits(dec->wide)) + 1;
+      if (lead + len > w) {
+        dec->end = true;
+        return false;
+      }
+      dec->lead = lead;
+      dec->len = len;
+    } else if (dec->len == 0) {
+      dec->error = true;  // Window reuse before any window
+      return false;
+    }
+    *prev ^= (U)(xor_get<U>(br, dec->len) << (w - dec->lead - dec->len));
+  }
+  if (br->error) return false;
+  dec->count++;
+  return true;
+}
+
+void xor_encoder_init(xor_encoder *enc, uint8_t *buf, size_t size, bool wide) {
+  if (!enc) return;
+  bit_writer_init(&enc->bw, buf, size);
+  enc->prev.u64 = 0;
+  enc->count = 0;
+  enc->lead = 0;
+  enc->len = 0;
+  enc->wide = wide;
+}
+
+bool xor_write_float(xor_encoder *enc, float v) {
+  if (!enc || enc->wide || enc->bw.error) return false;
+  union32 u;
+  u.f = v;
+  return xor_encode(enc, u.u32, &enc->prev.u32[0]);
+}
+
+bool xor_write_double(xor_encoder *enc, double v) {
+  if (!enc || !enc->wide || enc->bw.error) return false;
+  union64 u;
+  u.u64 = 0;  // double is 32 bits on AVR
+  u.d = v;
+  return xor_encode(enc, u.u64, &enc->prev.u64);
+}
+
+size_t xor_finish(xor_encoder *enc) {
+  if (!enc) return 0;
+  if (enc->count) {
+    // End marker: a window wider than the value
+    bit_write(&enc->bw, 3, 2);
+    bit_write(&enc->bw, XOR_LEAD_MAX, XOR_LEAD_BITS);
+    bit_write(&enc->bw, 0xFF, xor_len_bits(enc->wide));
+  }
+  return bit_flush(&enc->bw);
+}
+
+float xor_ratio(const xor_encoder *enc) {
+  if (!enc) return 0;
+  size_t bytes = enc->bw.pos + (enc->bw.bits + 7) / 8;
+  if (bytes == 0) return 0;
+  return (float)enc->count * (enc->wide ? 8 : 4) / bytes;
+}
+
+void xor_decoder_init(xor_decoder *dec, const uint8_t *buf, size_t len, bool wide) {
+  if (!dec) return;
+  bit_reader_init(&dec->br, buf, len);
+  dec->prev.u64 = 0;
+  dec->count = 0;
+  dec->lead = 0;
+  dec->len = 0;
+  dec->wide = wide;
+  dec->end = false;
+  dec->error = false;
+}
+
+bool xor_read_float(xor_decoder *dec, float *v) {
+  if (!dec || !v || dec->wide || dec->error) return false;
+  if (!xor_decode(dec, &dec->prev.u32[0])) return false;
+  union32 u;
+  u.u32 = dec->prev.u32[0];
+  *v = u.f;
+  return true;
+}
+
+bool xor_read_double(xor_decoder *dec, double *v) {
+  if (!dec || !v || !dec->wide || dec->error) return false;
+  if (!xor_decode(dec, &dec->prev.u64)) return false;
+  union64 u;
+  u.u64 = dec->prev.u64;
+  *v = u.d;
+  return true;
+}
+
+// Hashed timer wheel: each running timer sits in the list of bucket
+// (deadline >> shift) & mask; a poll only visits the buckets of the ticks
+// that passed since the previous one. Deadlines compare like on_ms(), by
+// unsigned difference, so they work across the clock wraparound.
+static inline bool timer_due(uint32_t now, uint32_t deadline) {
+  return now - deadline < 0x80000000UL;
+}
+
+static void timer_unlink(timer_wheel *tw, uint16_t id) {
+  timer_node *n = &tw->nodes[id];
+  if (n->prev == TIMER_NONE) {
+    tw->buckets[(n->deadline >> tw->shift) & tw->mask] = n->next;
+  } else {
+    tw->nodes[n->prev].next = n->next;
+  }
+  if (n->next != TIMER_NONE) tw->nodes[n->next].prev = n->prev;
+  n->active = false;
+}
+
+bool timer_wheel_init(timer_wheel *tw, timer_node *nodes, uint16_t count, uint16_t *buckets, uint16_t bucket_count,
+                      uint32_t now, uint8_t shift) {
+  // Bucket count must be a power of two so the index is a mask
+  if (!tw || !nodes || !buckets || count == 0 || count == TIMER_NONE || bucket_count == 0 ||
+      (bucket_count & (bucket_count - 1)) || shift > 31) {
+    return false;
+  }
+  tw->nodes = nodes;
+  tw->count = count;
+  tw->buckets = buckets;
+  tw->mask = bucket_count - 1;
+  tw->shift = shift;
+  tw->now = now;
+  tw->tick = now >> shift;
+  for (uint16_t i = 0; i < count; i++) nodes[i].active = false;
+  for (uint16_t i = 0; i < bucket_count; i++) buckets[i] = TIMER_NONE;
+  return true;
+}
+
+bool timer_start(timer_wheel *tw, uint16_t id, uint32_t delay) {
+  if (!tw || id >= tw->count || delay > 0x7FFFFFFFUL) return false;
+  timer_node *n = &tw->nodes[id];
+  if (n->active) timer_unlink(tw, id);
+  n->deadline = tw->now + delay;
+  uint16_t *head = &tw->buckets[(n->deadline >> tw->shift) & tw->mask];
+  n->prev = TIMER_NONE;
+  n->next = *head;
+  if (*head != TIMER_NONE) tw->nodes[*head].prev = id;
+  *head = id;
+  n->active = true;
+  return true;
+}
+
+bool timer_cancel(timer_wheel *tw, uint16_t id) {
+  if (!tw || id >= tw->count || !tw->nodes[id].active) return false;
+  timer_unlink(tw, id);
+  return true;
+}
+
+bool timer_active(const timer_wheel *tw, uint16_t id) {
+  return tw && id < tw->count && tw->nodes[id].active;
+}
+
+size_t timer_wheel_poll(timer_wheel *tw, uint32_t now, uint16_t *expired, size_t max) {
+  if (!tw || !expired || max == 0) return 0;
+  tw->now = now;
+  uint32_t now_tick = now >> tw->shift;
+  // The current tick is visited again by the next poll: its later deadlines
+  // may fall due before the tick ends
+  uint32_t span = now_tick - tw->tick;
+  if (span > tw->mask) span = tw->mask;  // A long gap: every bucket once
+  size_t found = 0;
+  for (uint32_t t = now_tick - span; ; t++) {
+    uint16_t id = tw->buckets[t & tw->mask];
+    while (id != TIMER_NONE) {
+      uint16_t next = tw->nodes[id].next;
+      if (timer_due(now, tw->nodes[id].deadline)) {
+        if (found == max) {
+          // Output full: resume from this bucket next time
+          tw->tick = t;
+          return found;
+        }
+        timer_unlink(tw, id);
+        expired[found++] = id;
+      }
+      id = next;
+    }
+    if (t == now_tick) break;
+  }
+  tw->tick = now_tick;
+  return found;
 }
 
 #ifdef ARDUINO
@@ -96,15 +993,131 @@ bool on_us(uint32_t *t, uint32_t delay_us, bool reset) {
   return false;
 }
 
-void delay_us(uint32_t start, uint32_t wait_us) {
-  // Avoid invalid or excessive delays (e.g., > 71 minutes)
-  if (wait_us == 0 || wait_us > 0xFFFFFFFF / 2) {
-    return;  // Invalid or too large delay
-  }
+// 64-bit clocks: each keeps the number of half-range periods of its 32-bit
+// clock seen so far. Its low bit must match the clock's top bit; a mismatch
+// means the clock crossed into the next half. The count is only ever derived
+// from the clock, so a racing ISR can at worst leave it one half behind, which
+// the next read corrects. A clock must be read at least once per half range.
+static volatile uint32_t clock_us_halves = 0;
+static volatile uint32_t clock_ms_halves = 0;
 
-  // Wait until the specified time has elapsed
-  uint32_t diff;
-  do {
+static inline uint32_t clock_load(const volatile uint32_t *halves) {
+#ifdef __AVR__
+  // 32-bit accesses are not atomic on AVR
+  uint8_t sreg = SREG;
+  cli();
+  uint32_t h = *halves;
+  SREG = sreg;
+  return h;
+#else
+  return *halves;
+#endif
+}
+
+static inline uint64_t clock_extend(volatile uint32_t *halves, uint32_t h, uint32_t now) {
+  if ((now >> 31) != (h & 1)) {
+    h++;
+#ifdef __AVR__
+    uint8_t sreg = SREG;
+    cli();
+    *halves = h;
+    SREG = sreg;
+#else
+    *halves = h;
+#endif
+  }
+  return ((uint64_t)(h >> 1) << 32) | now;
+}
+
+uint64_t micros64() {
+  // Load the count before reading the clock, so it is never ahead of it
+  uint32_t h = clock_load(&clock_us_halves);
+  return clock_extend(&clock_us_halves, h, micros());
+}
+
+uint64_t millis64() {
+  uint32_t h = clock_load(&clock_ms_halves);
+  return clock_extend(&clock_ms_halves, h, millis());
+}
+
+static bool on_elapsed64(uint64_t *t, uint64_t current, uint64_t threshold, bool reset) {
+  if (current - *t >= threshold) {
+    if (reset) *t = current;
+    return true;
+  }
+  return false;
+}
+
+bool on_min64(uint64_t *t, uint64_t delay_min, bool reset) {
+  if (!t) return false;
+  return on_elapsed64(t, millis64(), delay_min * 60000ULL, reset);
+}
+
+bool on_sec64(uint64_t *t, uint64_t delay_sec, bool reset) {
+  if (!t) return false;
+  return on_elapsed64(t, millis64(), delay_sec * 1000ULL, reset);
+}
+
+bool on_ms64(uint64_t *t, uint64_t delay_ms, bool reset) {
+  if (!t) return false;
+  return on_elapsed64(t, millis64(), delay_ms, reset);
+}
+
+bool on_us64(uint64_t *t, uint64_t delay_us, bool reset) {
+  if (!t) return false;
+  return on_elapsed64(t, micros64(), delay_us, reset);
+}
+
+// Advances *t by whole periods instead of setting it to the current time, so
+// the schedule keeps its phase however late the check runs
+static uint32_t every_tick(uint32_t *t, uint32_t current, uint32_t period, bool catch_up) {
+  uint32_t diff = current - *t;
+  if (diff < period) return 0;
+
+  // Catching up moves one period per call, so the missed ones fire next
+  if (catch_up) {
+    *t += period;
+    return 1;
+  }
+
+  // Avoid the division in the common on-time case
+  uint32_t due = 1;
+  diff -= period;
+  if (diff >= period) due += diff / period;
+
+  *t += due * period;
+  return due;
+}
+
+uint32_t every_min(uint32_t *t, uint32_t period_min, bool catch_up) {
+  if (!t || period_min == 0) return 0;
+  return every_tick(t, millis(), period_min * 60000UL, catch_up);
+}
+
+uint32_t every_sec(uint32_t *t, uint32_t period_sec, bool catch_up) {
+  if (!t || period_sec == 0) return 0;
+  return every_tick(t, millis(), period_sec * 1000UL, catch_up);
+}
+
+uint32_t every_ms(uint32_t *t, uint32_t period_ms, bool catch_up) {
+  if (!t || period_ms == 0) return 0;
+  return every_tick(t, millis(), period_ms, catch_up);
+}
+
+uint32_t every_us(uint32_t *t, uint32_t period_us, bool catch_up) {
+  if (!t || period_us == 0) return 0;
+  return every_tick(t, micros(), period_us, catch_up);
+}
+
+void delay_us(uint32_t start, uint32_t wait_us) {
+  // Avoid invalid or excessive delays (e.g., > 71 minutes)
+  if (wait_us == 0 || wait_us > 0xFFFFFFFF / 2) {
+    return;  // Invalid or too large delay
+  }
+
+  // Wait until the specified time has elapsed
+  uint32_t diff;
+  do {
     diff = micros() - start;  // Handles overflow
     yield();                  // Allow background tasks in Arduino environment
   } while (diff < wait_us);
@@ -123,6 +1136,80 @@ void delay_ms(uint32_t start, uint32_t wait_ms) {
     yield();                  // Allow background tasks in Arduino environment
   } while (diff < wait_ms);
 }
+
+// Deadlines are ordered by signed difference, which stays consistent while
+// all pending waits are shorter than half the micros() range
+static inline bool sched_before(const task *a, const task *b) {
+  return (int32_t)(a->deadline - b->deadline) < 0;
+}
+
+static void sched_push(scheduler *s, task *tk) {
+  uint8_t i = s->size++;
+  while (i > 0) {
+    uint8_t parent = (i - 1) / 2;
+    if (!sched_before(tk, s->heap[parent])) break;
+    s->heap[i] = s->heap[parent];
+    i = parent;
+  }
+  s->heap[i] = tk;
+}
+
+static void sched_pop(scheduler *s) {
+  task *last = s->heap[--s->size];
+  uint8_t i = 0;
+  for (;;) {
+    uint8_t child = 2 * i + 1;
+    if (child >= s->size) break;
+    if (child + 1 < s->size && sched_before(s->heap[child + 1], s->heap[child])) child++;
+    if (!sched_before(s->heap[child], last)) break;
+    s->heap[i] = s->heap[child];
+    i = child;
+  }
+  if (s->size) s->heap[i] = last;
+}
+
+bool sched_init(scheduler *s, task **heap, uint8_t cap) {
+  if (!s || !heap || cap == 0) return false;
+  s->heap = heap;
+  s->size = 0;
+  s->cap = cap;
+  s->now = micros();
+  return true;
+}
+
+bool sched_add(scheduler *s, task *tk, task_fn fn, void *arg, uint32_t delay_us) {
+  if (!s || !tk || !fn || s->size == s->cap || delay_us > 0x7FFFFFFFUL) return false;
+  tk->fn = fn;
+  tk->arg = arg;
+  tk->lc = 0;
+  tk->wait = 0;
+  tk->deadline = micros() + delay_us;
+  sched_push(s, tk);
+  return true;
+}
+
+uint32_t sched_run(scheduler *s) {
+  if (!s || s->size == 0) return 0xFFFFFFFFUL;
+  s->now = micros();
+  task *tk = s->heap[0];
+  uint32_t wait = tk->deadline - s->now;
+  if (wait < 0x80000000UL && wait != 0) return wait;  // Nothing due yet
+
+  sched_pop(s);
+  switch (tk->fn(tk)) {
+    case TASK_WAITING:
+      tk->deadline = s->now + tk->wait;
+      sched_push(s, tk);
+      break;
+    case TASK_READY:
+      tk->deadline = s->now;
+      sched_push(s, tk);
+      break;
+    default:  // TASK_DONE: drop it
+      break;
+  }
+  return 0;
+}
 #endif
 
 char *bool_to_str(bool num, char *str, uint8_t str_len, const char *t, const char *f) {
@@ -289,6 +1376,123 @@ char *u64_to_str(uint64_t num, char *str, uint8_t str_len, uint8_t base) {
   return str;
 }
 
+// Fixed-point formatter shared by join_float / join_double.
+// The decimal power, its integer counterpart and the overflow limit are set up
+// once per join call; each element is then scaled with a single multiply,
+// rounded exactly as double_to_str would, and its digits are written straight
+// into the output buffer (no printf/dtostrf).
+#ifdef __AVR__
+typedef uint32_t fixed_acc_t;
+#define FIXED_ACC_LIMIT 4294967295.0
+#else
+typedef uint64_t fixed_acc_t;
+#define FIXED_ACC_LIMIT 18446744073709549568.0  // Largest double below 2^64
+#endif
+
+static const fixed_acc_t fixed_pow10[MAX_DECIMAL + 1] = {
+    1UL, 10UL, 100UL, 1000UL, 10000UL, 100000UL, 1000000UL,
+#ifndef __AVR__
+    10000000ULL, 100000000ULL, 1000000000ULL, 10000000000ULL, 100000000000ULL,
+    1000000000000ULL, 10000000000000ULL, 100000000000000ULL, 1000000000000000ULL,
+#endif
+};
+
+struct fixed_fmt {
+  fixed_acc_t div;  // 10^dec as integer, splits integer and fractional digits
+  double scale;     // 10^dec as double
+  double limit;     // Largest |num| * scale that still fits fixed_acc_t
+  uint8_t dec;      // Number of decimal places
+};
+
+static bool fixed_fmt_init(fixed_fmt *f, uint8_t dec) {
+  if (dec > MAX_DECIMAL) return false;
+  f->dec = dec;
+  f->div = fixed_pow10[dec];
+  f->scale = (double)f->div;
+  f->limit = FIXED_ACC_LIMIT - 1.0;
+  return true;
+}
+
+// Rounds a * 10^dec (a >= 0, below the limit) to an integer the way
+// double_to_str does: on the exact value, not on the rounded product
+static fixed_acc_t fixed_round(const fixed_fmt *f, double a, double x) {
+#ifdef __AVR__
+  // double is a float here: the 24-bit mantissa times 10^dec fits 64 bits,
+  // and dtostrf rounds halves up
+  int exp;
+  uint32_t m = (uint32_t)ldexp(frexp(a, &exp), 24);
+  uint64_t p = (uint64_t)m * f->div;
+  int16_t sh = 24 - exp;
+  if (sh <= 0) return (fixed_acc_t)(p << -sh);
+  if (sh > 63) return 0;  // Far below 0.5
+  fixed_acc_t v = (fixed_acc_t)(p >> sh);
+  uint64_t rem = p & (((uint64_t)1 << sh) - 1);
+  uint64_t half = (uint64_t)1 << (sh - 1);
+  return rem >= half ? v + 1 : v;
+#else
+  // a * scale == x + e exactly, and printf breaks exact ties to even
+  double e = fma(a, f->scale, -x);
+  double t = floor(x);
+  fixed_acc_t v = (fixed_acc_t)t;
+  double d = x - t;
+  if (d == 0 && x >= 4503599627370496.0) {
+    // x >= 2^52 is an integer; the fraction is in e, which may exceed 1
+    double ie = floor(e);
+    d = e - ie;
+    e = 0;
+    v += (fixed_acc_t)(int64_t)ie;
+  }
+  // The fraction is d + e, with |e| far below the step of d
+  if (d < 0.25) return v;
+  double h = d - 0.5;  // Exact for d in [0.25, 1)
+  if (h > -e || (h == -e && (v & 1))) v++;
+  return v;
+#endif
+}
+
+// Writes num into out (at most room bytes, no terminator).
+// Returns the number of characters written, or 0 if it does not fit.
+static size_t fixed_fmt_put(const fixed_fmt *f, double num, char *out, size_t room) {
+  bool neg = signbit(num);
+  double a = neg ? -num : num;
+  double scaled = a * f->scale;
+
+  // Out of range, NaN or infinity: take the generic path for this element
+  if (!(scaled < f->limit)) {
+    char temp[DOUBLE_CHR_MAX + 8];
+    if (!double_to_str(num, temp, sizeof(temp), 0, f->dec)) return 0;
+    size_t temp_len = strlen(temp);
+    if (temp_len > room) return 0;
+    memcpy(out, temp, temp_len);
+    return temp_len;
+  }
+
+  fixed_acc_t v = fixed_round(f, a, scaled);
+  fixed_acc_t ip = v / f->div;
+  fixed_acc_t fp = v - ip * f->div;
+
+  // Count integer digits to know the final length before writing
+  uint8_t int_digits = 1;
+  for (fixed_acc_t t = ip; t >= 10; t /= 10) int_digits++;
+  size_t len = (neg ? 1 : 0) + int_digits + (f->dec ? 1 + f->dec : 0);
+  if (len > room) return 0;
+
+  // Fill right to left directly in the output
+  char *p = out + len;
+  for (uint8_t i = 0; i < f->dec; i++) {
+    *--p = '0' + (char)(fp % 10);
+    fp /= 10;
+  }
+  if (f->dec) *--p = '.';
+  do {
+    *--p = '0' + (char)(ip % 10);
+    ip /= 10;
+  } while (ip);
+  if (neg) *--p = '-';
+
+  return len;
+}
+
 char *float_to_str(float num, char *str, uint8_t str_len, int8_t min_width, uint8_t dec) {
   return double_to_str(num, str, str_len, min_width, dec);
 }
@@ -312,7 +1516,8 @@ char *double_to_str(double num, char *str, uint8_t str_len, int8_t min_width, ui
   // ESP32: snprintf használata 64-bites double-hoz
   char fmt[12];
   snprintf(fmt, sizeof(fmt), "%%%d.%dlf", min_width, dec);
-  if (snprintf(ret.data(), ret.size(), fmt, num) >= ret.size()) {
+  int len = snprintf(str, str_len, fmt, num);
+  if (len < 0 || len >= str_len) {
     return NULL;
   }
 #endif
@@ -718,14 +1923,19 @@ char *str_reverse(char *str) {
   if (!str) {
     return NULL;  // Invalid string pointer
   }
+  return str_reverse(str, strlen(str));
+}
 
-  // Get string length
-  size_t len = strlen(str);
-  size_t i, j;
-  char temp;
+char *str_reverse(char *str, size_t str_len) {
+  // Validate input
+  if (!str) {
+    return NULL;  // Invalid string pointer
+  }
+  if (str_len < 2) return str;
 
   // Swap characters from start and end until meeting in the middle
-  for (i = 0, j = len - 1; i < j; i++, j--) {
+  char temp;
+  for (size_t i = 0, j = str_len - 1; i < j; i++, j--) {
     temp = str[i];
     str[i] = str[j];
     str[j] = temp;
@@ -734,25 +1944,152 @@ char *str_reverse(char *str) {
   return str;
 }
 
-size_t chr_count(const char *str, char c) {
-  if (!str) return 0;
+// Block helpers shared by both chr_count overloads. Each adds the bytes equal to
+// c in one block to *count, or returns false without counting if the block holds
+// the terminator. They take loaded values; the callers do the loads.
+#if defined(__AVX2__)
+#define CHR_VEC 32
+#define CHR_VEC_LOAD(p) _mm256_load_si256((const __m256i *)(p))
+typedef __m256i chr_vec;
+
+static inline chr_vec chr_splat(char c) {
+  return _mm256_set1_epi8(c);
+}
+
+static inline bool chr_vec_count(chr_vec v, chr_vec vc, size_t *count) {
+  if (_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, _mm256_setzero_si256()))) return false;
+  *count += __builtin_popcount((uint32_t)_mm256_movemask_epi8(_mm256_cmpeq_epi8(v, vc)));
+  return true;
+}
+#elif defined(__SSE2__)
+#define CHR_VEC 16
+#define CHR_VEC_LOAD(p) _mm_load_si128((const __m128i *)(p))
+typedef __m128i chr_vec;
+
+static inline chr_vec chr_splat(char c) {
+  return _mm_set1_epi8(c);
+}
+
+static inline bool chr_vec_count(chr_vec v, chr_vec vc, size_t *count) {
+  if (_mm_movemask_epi8(_mm_cmpeq_epi8(v, _mm_setzero_si128()))) return false;
+  *count += __builtin_popcount((uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v, vc)));
+  return true;
+}
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+#define CHR_VEC 16
+#define CHR_VEC_LOAD(p) vld1q_u8((const uint8_t *)(p))
+typedef uint8x16_t chr_vec;
+
+static inline chr_vec chr_splat(char c) {
+  return vdupq_n_u8((uint8_t)c);
+}
+
+static inline bool chr_vec_count(chr_vec v, chr_vec vc, size_t *count) {
+  if (vminvq_u8(v) == 0) return false;
+  *count += vaddvq_u8(vandq_u8(vceqq_u8(v, vc), vdupq_n_u8(1)));
+  return true;
+}
+#endif
+
+static inline bool chr_word_count(swar_t v, swar_t pattern, size_t *count) {
+  if (swar_zero(v)) return false;
+  const swar_t low7 = ~SWAR_HIGHS;
+  swar_t x = v ^ pattern;
+  swar_t eq = ~(((x & low7) + low7) | x | low7) >> 7;  // 1 in every byte equal to c
+  // Sum the bytes by folding halves, which avoids a multiply on AVR
+  for (uint8_t shift = 4 * sizeof(swar_t); shift >= 8; shift /= 2) eq += eq >> shift;
+  *count += (uint8_t)eq;
+  return true;
+}
+
+// The null-terminated scan tests whole aligned blocks for the terminator and
+// for c in the same step. Aligned loads never cross a page boundary, so reading
+// the block that holds the terminator is safe. That block may extend past the
+// end of the allocation on purpose, so AddressSanitizer is kept out of this
+// function (and only this one).
+#if defined(__GNUC__) && !defined(__AVR__)
+#define CHR_NO_ASAN __attribute__((no_sanitize_address))
+#else
+#define CHR_NO_ASAN
+#endif
+
+#ifdef CHR_VEC
+#define CHR_BLOCK CHR_VEC
+#else
+#define CHR_BLOCK sizeof(swar_t)
+#endif
+
+// swar_load() without the sanitizer checks, which would stay if it were called
+CHR_NO_ASAN static inline swar_t chr_load(const char *p) {
+  swar_t v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+CHR_NO_ASAN static size_t chr_count_nul(const char *p, char c) {
   size_t count = 0;
-  while (*str != '\0') {
-    if (*str++ == c) count++;
+
+  // Head: bytes up to the first aligned block
+  while ((uintptr_t)p & (CHR_BLOCK - 1)) {
+    if (*p == '\0') return count;
+    if (*p == c) count++;
+    p++;
+  }
+
+#ifdef CHR_VEC
+  const chr_vec vc = chr_splat(c);
+  while (chr_vec_count(CHR_VEC_LOAD(p), vc, &count)) p += CHR_VEC;
+#endif
+
+  const swar_t pattern = SWAR_ONES * (uint8_t)c;
+  while (chr_word_count(chr_load(p), pattern, &count)) p += sizeof(swar_t);
+
+  // The word holding the terminator
+  for (; *p != '\0'; p++) {
+    if (*p == c) count++;
   }
   return count;
 }
 
+size_t chr_count(const char *str, char c) {
+  if (!str || c == '\0') return 0;
+  return chr_count_nul(str, c);
+}
+
 size_t chr_count(const char *str, size_t str_len, char c) {
   // Validate input
-  if (!str) return 0;
+  if (!str || c == '\0') return 0;
 
+  // Count up to str_len characters or until null terminator, never reading past
+  // str_len. Blocks stay aligned, so a str_len beyond a shorter string is harmless.
   size_t count = 0;
-  // Iterate up to str_len characters or until null terminator
-  for (size_t i = 0; i < str_len && str[i] != '\0'; i++) {
-    if (str[i] == c) count++;
+  const char *p = str;
+  size_t n = str_len;
+  while (n && ((uintptr_t)p & (CHR_BLOCK - 1))) {
+    if (*p == '\0') return count;
+    if (*p == c) count++;
+    p++;
+    n--;
+  }
+
+#ifdef CHR_VEC
+  const chr_vec vc = chr_splat(c);
+  while (n >= CHR_VEC && chr_vec_count(CHR_VEC_LOAD(p), vc, &count)) {
+    p += CHR_VEC;
+    n -= CHR_VEC;
+  }
+#endif
+
+  const swar_t pattern = SWAR_ONES * (uint8_t)c;
+  while (n >= sizeof(swar_t) && chr_word_count(swar_load(p), pattern, &count)) {
+    p += sizeof(swar_t);
+    n -= sizeof(swar_t);
   }
 
+  // Tail, or the block holding the terminator
+  for (; n && *p != '\0'; p++, n--) {
+    if (*p == c) count++;
+  }
   return count;
 }
 
@@ -771,23 +2108,251 @@ void str_count(char *str, char **ar, char delim) {
   }
 }
 
-size_t str_count(const char *str, const char *find) {
-  if (!str || !find) return 0;  // NULL check
-  size_t count = 0;
-  size_t len = strlen(find);
-  size_t str_len = strlen(str);
+// Substring search used by str_find, str_find_all and str_count.
+// Short needles use a first-byte/last-byte filter (16 positions per step with
+// SSE2, memchr on the first byte elsewhere) and only memcmp the candidates.
+// Needles of STR_FIND_LONG bytes or more use Horspool's bad-character shifts;
+// on AVR the 256-byte shift table is not worth the RAM and the filter is kept.
+#define STR_FIND_LONG 32
+
+struct str_finder {
+  const char *find;  // Needle
+  size_t len;        // Needle length (at least 1)
+#ifndef __AVR__
+  uint8_t shift[256];  // Horspool shifts (capped at 255), long needles only
+#endif
+};
+
+static void str_finder_init(str_finder *f, const char *find, size_t len) {
+  f->find = find;
+  f->len = len;
+#ifndef __AVR__
+  if (len < STR_FIND_LONG) return;
+  uint8_t def = len > 255 ? 255 : (uint8_t)len;
+  memset(f->shift, def, sizeof(f->shift));
+  for (size_t i = 0; i + 1 < len; i++) {
+    size_t sh = len - 1 - i;
+    f->shift[(uint8_t)find[i]] = sh > 255 ? 255 : (uint8_t)sh;
+  }
+#endif
+}
 
-  if (len == 0) return 0;  // empty
+// First occurrence of the needle in [str, str + n), or NULL
+static const char *str_finder_next(const str_finder *f, const char *str, size_t n) {
+  size_t m = f->len;
+  if (n < m) return NULL;
+  const char first = f->find[0];
+  const char last = f->find[m - 1];
+
+  if (m == 1) return (const char *)memchr(str, first, n);
+
+#ifndef __AVR__
+  if (m >= STR_FIND_LONG) {
+    size_t i = 0;
+    while (i <= n - m) {
+      char c = str[i + m - 1];
+      if (c == last && !memcmp(str + i, f->find, m - 1)) return str + i;
+      i += f->shift[(uint8_t)c];
+    }
+    return NULL;
+  }
+#endif
 
-  for (size_t i = 0; i <= str_len - len; i++) {
-    if (!strncmp(str + i, find, len)) {
-      count++;
-      i += len - 1;  // Jump to the next posizition
+  size_t i = 0;
+#if defined(__SSE2__)
+  __m128i vf = _mm_set1_epi8(first);
+  __m128i vl = _mm_set1_epi8(last);
+  for (; i + m - 1 + 16 <= n; i += 16) {
+    __m128i bf = _mm_loadu_si128((const __m128i *)(str + i));
+    __m128i bl = _mm_loadu_si128((const __m128i *)(str + i + m - 1));
+    uint32_t cand = (uint32_t)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(bf, vf), _mm_cmpeq_epi8(bl, vl)));
+    while (cand) {
+      size_t at = i + __builtin_ctz(cand);
+      if (!memcmp(str + at + 1, f->find + 1, m - 2)) return str + at;
+      cand &= cand - 1;
     }
   }
+#endif
+  while (i <= n - m) {
+    const char *p = (const char *)memchr(str + i, first, n - m + 1 - i);
+    if (!p) return NULL;
+    if (p[m - 1] == last && !memcmp(p + 1, f->find + 1, m - 2)) return p;
+    i = p - str + 1;
+  }
+  return NULL;
+}
+
+const char *str_find(const char *str, const char *find) {
+  if (!str) return NULL;
+  return str_find(str, strlen(str), find);
+}
+
+const char *str_find(const char *str, size_t str_len, const char *find) {
+  if (!str || !find || !*find) return NULL;
+  str_finder f;
+  str_finder_init(&f, find, strlen(find));
+  return str_finder_next(&f, str, str_len);
+}
+
+size_t str_find_all(const char *str, const char *find, size_t *pos, size_t pos_size) {
+  if (!str) return 0;
+  return str_find_all(str, strlen(str), find, pos, pos_size);
+}
+
+size_t str_find_all(const char *str, size_t str_len, const char *find, size_t *pos, size_t pos_size) {
+  if (!str || !find || !*find) return 0;
+
+  str_finder f;
+  str_finder_init(&f, find, strlen(find));
+
+  size_t count = 0;
+  size_t off = 0;
+  const char *p;
+  while ((p = str_finder_next(&f, str + off, str_len - off)) != NULL) {
+    if (pos && count < pos_size) pos[count] = p - str;
+    count++;
+    off = p - str + f.len;  // Matches do not overlap
+  }
   return count;
 }
 
+size_t str_count(const char *str, const char *find) {
+  return str_find_all(str, find, NULL, 0);
+}
+
+size_t str_count(const char *str, size_t str_len, const char *find) {
+  return str_find_all(str, str_len, find, NULL, 0);
+}
+
+// Aho-Corasick: a keyword trie stored as first-child/next-sibling lists, with
+// failure links and dictionary links (next keyword-ending state on the failure
+// chain) so every match is reported while each input byte is read once.
+static inline void ac_read(const ac_matcher *m, uint16_t i, ac_node *n) {
+#ifdef __AVR__
+  if (m->progmem) {
+    memcpy_P(n, &m->nodes[i], sizeof(*n));
+    return;
+  }
+#endif
+  *n = m->nodes[i];
+}
+
+// Child of node with edge c, or 0
+static uint16_t ac_child(const ac_matcher *m, uint16_t node, char c) {
+  ac_node n;
+  ac_read(m, node, &n);
+  for (uint16_t i = n.child; i; i = n.next) {
+    ac_read(m, i, &n);
+    if (n.ch == c) return i;
+  }
+  return 0;
+}
+
+bool ac_build(ac_matcher *m, ac_node *nodes, uint16_t nodes_size, const char *const *kw, uint8_t kw_count) {
+  if (!m || !nodes || nodes_size == 0 || !kw || kw_count == 0) return false;
+
+  ac_attach(m, nodes, 1, kw_count);
+  memset(&nodes[0], 0, sizeof(nodes[0]));
+
+  // Trie
+  for (uint8_t k = 0; k < kw_count; k++) {
+    const char *p = kw[k];
+    if (!p || !*p || strlen(p) > 255) return false;
+    uint16_t node = 0;
+    for (; *p; p++) {
+      uint16_t c = ac_child(m, node, *p);
+      if (!c) {
+        if (m->count == nodes_size) return false;
+        c = m->count++;
+        nodes[c].ch = *p;
+        nodes[c].depth = nodes[node].depth + 1;
+        nodes[c].out = 0;
+        nodes[c].child = 0;
+        nodes[c].next = nodes[node].child;
+        nodes[c].fail = 0;
+        nodes[c].dict = 0;
+        nodes[node].child = c;
+      }
+      node = c;
+    }
+    if (!nodes[node].out) nodes[node].out = k + 1;
+  }
+
+  // Failure and dictionary links, level by level (a failure target is always shallower)
+  for (uint16_t depth = 0; depth < 255; depth++) {
+    bool more = false;
+    for (uint16_t u = 0; u < m->count; u++) {
+      if (nodes[u].depth != depth) continue;
+      for (uint16_t v = nodes[u].child; v; v = nodes[v].next) {
+        more = true;
+        uint16_t f = 0;
+        if (u != 0) {
+          f = nodes[u].fail;
+          uint16_t t;
+          while (!(t = ac_child(m, f, nodes[v].ch)) && f) f = nodes[f].fail;
+          f = t;
+        }
+        nodes[v].fail = f;
+        nodes[v].dict = f ? (nodes[f].out ? f : nodes[f].dict) : 0;
+      }
+    }
+    if (!more) break;
+  }
+  return true;
+}
+
+void ac_attach(ac_matcher *m, const ac_node *nodes, uint16_t count, uint8_t kw_count) {
+  if (!m) return;
+  m->nodes = nodes;
+  m->count = count;
+  m->keywords = kw_count;
+  m->progmem = false;
+}
+
+#ifdef __AVR__
+void ac_attach_P(ac_matcher *m, const ac_node *nodes, uint16_t count, uint8_t kw_count) {
+  if (!m) return;
+  ac_attach(m, nodes, count, kw_count);
+  m->progmem = true;
+}
+#endif
+
+size_t ac_scan(const ac_matcher *m, const char *str, size_t len, size_t *counts, size_t *first) {
+  if (!m || !m->nodes || !str) return 0;
+
+  for (uint8_t k = 0; k < m->keywords; k++) {
+    if (counts) counts[k] = 0;
+    if (first) first[k] = (size_t)-1;
+  }
+
+  size_t total = 0;
+  uint16_t state = 0;
+  ac_node n;
+  for (size_t i = 0; i < len; i++) {
+    // Follow failure links until the character can be consumed
+    uint16_t next;
+    while (!(next = ac_child(m, state, str[i])) && state) {
+      ac_read(m, state, &n);
+      state = n.fail;
+    }
+    state = next;
+    if (!state) continue;
+
+    // Report the keyword ending here and every shorter one on the dictionary chain
+    ac_read(m, state, &n);
+    uint16_t o = n.out ? state : n.dict;
+    while (o) {
+      ac_read(m, o, &n);
+      uint8_t k = n.out - 1;
+      if (counts) counts[k]++;
+      if (first && first[k] == (size_t)-1) first[k] = i + 1 - n.depth;
+      total++;
+      o = n.dict;
+    }
+  }
+  return total;
+}
+
 const char **str_cut(char *str, const char **ar, size_t ar_size, char delim) {
   // Check for NULL pointers or invalid max_ar_size
   if (!str || !ar || ar_size == 0) return NULL;
@@ -813,6 +2378,27 @@ const char **str_cut(char *str, const char **ar, size_t ar_size, char delim) {
   return ar;
 }
 
+size_t str_cut(char *str, size_t str_len, const char **ar, size_t *ar_len, size_t ar_size, char delim) {
+  // Check for NULL pointers or invalid max_ar_size
+  if (!str || !ar || ar_size == 0) return 0;
+
+  char *end = str + str_len;
+  char *tmp = str;  // Start of the current substring
+  size_t it = 0;
+  while (it < ar_size) {
+    char *next = (char *)memchr(tmp, delim, end - tmp);
+    ar[it] = tmp;
+    if (ar_len) ar_len[it] = (next ? next : end) - tmp;
+    it++;
+    // The last substring is left as is; the buffer may not have room for a terminator
+    if (!next) break;
+    *next = '\0';
+    tmp = next + 1;
+    if (tmp == end) break;
+  }
+  return it;
+}
+
 char *join_chr_arr(const char *ar, size_t ar_size, char *buf, size_t buf_size, char delim) {
   if (!ar || !buf || ar_size == 0 || buf_size == 0) {
     return 0;
@@ -840,17 +2426,16 @@ char *join_bool(const bool *ar, size_t ar_size, char *buf, size_t buf_size, char
   char *ptr = buf;              // Current position in the buffer
   size_t remaining = buf_size;  // Remaining space in the buffer
 
+  // Both words are measured once, not formatted and measured per element
+  const char *true_str = t ? t : "true";
+  const char *false_str = f ? f : "false";
+  size_t true_len = strlen(true_str);
+  size_t false_len = strlen(false_str);
+
   // Iterate through the boolean array
   for (size_t i = 0; i < ar_size; i++) {
-    // Temporary buffer for bool_to_str output (large enough for typical true/false strings)
-    char temp[32];
-    // Convert boolean to string using bool_to_str
-    if (!bool_to_str(ar[i], temp, sizeof(temp), t, f)) {
-      *ptr = '\0';  // Terminate the string
-      return NULL;  // Conversion failed
-    }
-
-    size_t temp_len = strlen(temp);
+    const char *temp = ar[i] ? true_str : false_str;
+    size_t temp_len = ar[i] ? true_len : false_len;
     bool needs_delimiter = (i < ar_size - 1);
 
     // Check if there's enough space for the string, delimiter (if needed), and null terminator
@@ -859,8 +2444,8 @@ char *join_bool(const bool *ar, size_t ar_size, char *buf, size_t buf_size, char
       return NULL;  // Buffer overflow
     }
 
-    // Copy the converted string to the buffer
-    strcpy(ptr, temp);
+    // Copy the word to the buffer
+    memcpy(ptr, temp, temp_len);
     ptr += temp_len;
     remaining -= temp_len;
 
@@ -1151,22 +2736,26 @@ char *join_float(const float *ar, size_t ar_size, char *buf, size_t buf_size, ui
     return 0;
   }
 
+  fixed_fmt fmt;
+  if (!fixed_fmt_init(&fmt, dec)) {
+    *buf = '\0';
+    return 0;
+  }
+
   char *ptr = buf;
   size_t remaining = buf_size;
 
-  char temp[32];
   for (size_t i = 0; i < ar_size; i++) {
-    float_to_str(ar[i], temp, 1, sizeof(temp), dec);
-
-    size_t temp_len = strlen(temp);
     bool needs_delimiter = (i < ar_size - 1);
 
-    if (temp_len + (needs_delimiter ? 1 : 0) + 1 > remaining) {
+    // Reserve the delimiter and the null terminator up front
+    size_t reserve = (needs_delimiter ? 1 : 0) + 1;
+    size_t temp_len = remaining > reserve ? fixed_fmt_put(&fmt, ar[i], ptr, remaining - reserve) : 0;
+    if (temp_len == 0) {
       *ptr = '\0';
       return 0;
     }
 
-    memcpy(ptr, temp, temp_len);
     ptr += temp_len;
     remaining -= temp_len;
 
@@ -1185,22 +2774,26 @@ char *join_double(const double *ar, size_t ar_size, char *buf, size_t buf_size,
     return 0;
   }
 
+  fixed_fmt fmt;
+  if (!fixed_fmt_init(&fmt, dec)) {
+    *buf = '\0';
+    return 0;
+  }
+
   char *ptr = buf;
   size_t remaining = buf_size;
 
   for (size_t i = 0; i < ar_size; i++) {
-    char temp[32];
-    double_to_str(ar[i], temp, 1, sizeof(temp), dec);
-
-    size_t temp_len = strlen(temp);
     bool needs_delimiter = (i < ar_size - 1);
 
-    if (temp_len + (needs_delimiter ? 1 : 0) + 1 > remaining) {
+    // Reserve the delimiter and the null terminator up front
+    size_t reserve = (needs_delimiter ? 1 : 0) + 1;
+    size_t temp_len = remaining > reserve ? fixed_fmt_put(&fmt, ar[i], ptr, remaining - reserve) : 0;
+    if (temp_len == 0) {
       *ptr = '\0';
       return 0;
     }
 
-    memcpy(ptr, temp, temp_len);
     ptr += temp_len;
     remaining -= temp_len;
 
@@ -1246,26 +2839,57 @@ char *join_str(const char **ar, size_t ar_size, char *buf, size_t buf_size, char
   return buf;
 }
 
-bool *split_bool(const char *str, bool *ar, size_t ar_size, char delim, const char *t, const char *f) {
-  // Validate inputs
-  if (!str || !ar || ar_size == 0) {
-    return NULL;  // Invalid string, array, or size
+char *join_str(const char **ar, const size_t *ar_len, size_t ar_size, char *buf, size_t buf_size, char delim) {
+  if (!ar || !ar_len || !buf || ar_size == 0 || buf_size == 0) {
+    return 0;
   }
-  if (*str == '[') str++;
-  const char *token = str;
-  size_t i = 0;
 
-  // Process tokens until end of string or array limit
-  while (*token && i < ar_size) {
-    // Find next delimiter or end of string
-    char *next = strchr(token, delim);
-    if (next) {
-      *next = '\0';  // Temporarily terminate token
-    }
+  char *ptr = buf;
+  size_t remaining = buf_size;
 
-    // Parse token to boolean using str_to_bool
-    const char *endptr;
-    ar[i] = str_to_bool(token, &endptr, t, f);
+  for (size_t i = 0; i < ar_size; i++) {
+    size_t temp_len = ar[i] ? ar_len[i] : 0;
+    bool needs_delimiter = (i < ar_size - 1);
+
+    if (temp_len + (needs_delimiter ? 1 : 0) + 1 > remaining) {
+      *ptr = '\0';
+      return 0;
+    }
+
+    if (temp_len) memcpy(ptr, ar[i], temp_len);
+    ptr += temp_len;
+    remaining -= temp_len;
+
+    if (needs_delimiter) {
+      *ptr++ = delim;
+      remaining--;
+    }
+  }
+
+  *ptr = '\0';
+  return buf;
+}
+
+bool *split_bool(const char *str, bool *ar, size_t ar_size, char delim, const char *t, const char *f) {
+  // Validate inputs
+  if (!str || !ar || ar_size == 0) {
+    return NULL;  // Invalid string, array, or size
+  }
+  if (*str == '[') str++;
+  const char *token = str;
+  size_t i = 0;
+
+  // Process tokens until end of string or array limit
+  while (*token && i < ar_size) {
+    // Find next delimiter or end of string
+    char *next = strchr(token, delim);
+    if (next) {
+      *next = '\0';  // Temporarily terminate token
+    }
+
+    // Parse token to boolean using str_to_bool
+    const char *endptr;
+    ar[i] = str_to_bool(token, &endptr, t, f);
 
     // Check if parsing was successful (endptr moved)
     if (endptr == token) {
@@ -1288,6 +2912,11 @@ bool *split_bool(const char *str, bool *ar, size_t ar_size, char delim, const ch
 }
 
 char *split_quoted_str(const char *str, char *dest, size_t dest_size, const char **ar, size_t ar_size, char delim) {
+  if (!str) return NULL;
+  return split_quoted_str(str, strlen(str), dest, dest_size, ar, ar_size, delim);
+}
+
+char *split_quoted_str(const char *str, size_t str_len, char *dest, size_t dest_size, const char **ar, size_t ar_size, char delim) {
   // Validate inputs
   if (!str || !ar || !dest || ar_size == 0 || dest_size == 0) {
     return NULL;  // Invalid inputs
@@ -1304,8 +2933,9 @@ char *split_quoted_str(const char *str, char *dest, size_t dest_size, const char
   size_t current = 0;
   bool in_marked = false;  // Track if inside marked string
   const char *p = str;
+  const char *end = str + str_len;
   char *d = dest;
-  while (*p) {
+  while (p < end && *p) {
     if (current + 1 > dest_size) {
       *d++ = '\0';
       if (in_marked) ar[token] = NULL;
@@ -1325,7 +2955,7 @@ char *split_quoted_str(const char *str, char *dest, size_t dest_size, const char
         }
       } else if (*p == '\\') {
         if (in_marked) {
-          if (p[1] == '\"') {
+          if (p + 1 < end && p[1] == '\"') {
             *d++ = '\"';
             current++;
             p++;
@@ -1351,39 +2981,172 @@ char *split_quoted_str(const char *str, char *dest, size_t dest_size, const char
   return dest;
 }
 
+// Returns the first '"' or '\\' in [p, end), or end
+static char *quote_or_escape(char *p, char *end) {
+  while ((size_t)(end - p) >= sizeof(swar_t)) {
+    swar_t v = swar_load(p);
+    if (swar_eq(v, '"') | swar_eq(v, '\\')) break;
+    p += sizeof(swar_t);
+  }
+  while (p < end && *p != '"' && *p != '\\') p++;
+  return p;
+}
+
+static int8_t hex_val(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+// Parses 4 hex digits at p, returns -1 if invalid
+static int32_t hex4(const char *p, const char *end) {
+  if (end - p < 4) return -1;
+  int32_t v = 0;
+  for (uint8_t i = 0; i < 4; i++) {
+    int8_t h = hex_val(p[i]);
+    if (h < 0) return -1;
+    v = (v << 4) | h;
+  }
+  return v;
+}
+
+// Writes code point cp as UTF-8 at w, returns the byte count
+static uint8_t utf8_put(char *w, uint32_t cp) {
+  if (cp < 0x80) {
+    w[0] = (char)cp;
+    return 1;
+  }
+  if (cp < 0x800) {
+    w[0] = (char)(0xC0 | (cp >> 6));
+    w[1] = (char)(0x80 | (cp & 0x3F));
+    return 2;
+  }
+  if (cp < 0x10000) {
+    w[0] = (char)(0xE0 | (cp >> 12));
+    w[1] = (char)(0x80 | ((cp >> 6) & 0x3F));
+    w[2] = (char)(0x80 | (cp & 0x3F));
+    return 3;
+  }
+  w[0] = (char)(0xF0 | (cp >> 18));
+  w[1] = (char)(0x80 | ((cp >> 12) & 0x3F));
+  w[2] = (char)(0x80 | ((cp >> 6) & 0x3F));
+  w[3] = (char)(0x80 | (cp & 0x3F));
+  return 4;
+}
+
+size_t split_quoted_str_inplace(char *str, const char **ar, size_t *ar_len, size_t ar_size, char delim) {
+  if (!str) return 0;
+  return split_quoted_str_inplace(str, strlen(str), ar, ar_len, ar_size, delim);
+}
+
+size_t split_quoted_str_inplace(char *str, size_t str_len, const char **ar, size_t *ar_len, size_t ar_size, char delim) {
+  // Validate inputs
+  if (!str || !ar || ar_size == 0) return 0;
+
+  char *end = str + str_len;
+  char *r = str;  // Read position
+  size_t token = 0;
+
+  while (r < end && token < ar_size) {
+    // Outside quotes: skip whitespace, brackets and delimiters
+    if (*r != '"') {
+      if (*r != delim && *r != ' ' && *r != '\n' && *r != '\r' && *r != '\t' && *r != '[' && *r != ']') return token;
+      r++;
+      continue;
+    }
+
+    char *start = ++r;
+    char *w = r;  // Write position, never ahead of r
+    while (true) {
+      // Copy (or, before the first escape, just skip) the plain run
+      char *q = quote_or_escape(r, end);
+      if (w != r) memmove(w, r, q - r);
+      w += q - r;
+      r = q;
+
+      if (r == end) return token;  // Unterminated string, token dropped
+      if (*r == '"') break;
+
+      // Escape sequence
+      if (r + 1 == end) return token;  // Backslash at the end of the input
+      char c = r[1];
+      r += 2;
+      switch (c) {
+        case '"': *w++ = '"'; break;
+        case '\\': *w++ = '\\'; break;
+        case '/': *w++ = '/'; break;
+        case 'b': *w++ = '\b'; break;
+        case 'f': *w++ = '\f'; break;
+        case 'n': *w++ = '\n'; break;
+        case 'r': *w++ = '\r'; break;
+        case 't': *w++ = '\t'; break;
+        case 'u': {
+          int32_t cp = hex4(r, end);
+          if (cp < 0) {
+            *w++ = '\\';
+            *w++ = 'u';
+            break;
+          }
+          r += 4;
+          // Surrogate pair
+          if (cp >= 0xD800 && cp < 0xDC00 && r + 1 < end && r[0] == '\\' && r[1] == 'u') {
+            int32_t lo = hex4(r + 2, end);
+            if (lo >= 0xDC00 && lo < 0xE000) {
+              cp = 0x10000 + ((cp - 0xD800) << 10) + (lo - 0xDC00);
+              r += 6;
+            }
+          }
+          w += utf8_put(w, (uint32_t)cp);
+          break;
+        }
+        case '\0':
+          return token;  // Backslash at the end of the input
+        default:
+          // Unknown escape, keep it as written
+          *w++ = '\\';
+          *w++ = c;
+          break;
+      }
+    }
+
+    // r is at the closing quote; terminating at w never overwrites unread input
+    r++;
+    *w = '\0';
+    ar[token] = start;
+    if (ar_len) ar_len[token] = w - start;
+    token++;
+  }
+  return token;
+}
+
 const char **split_str(const char *str, char *dest, size_t dest_size, const char **ar, size_t ar_size, char delim) {
+  if (!str) return NULL;
+  return split_str(str, strlen(str), dest, dest_size, ar, ar_size, delim);
+}
+
+const char **split_str(const char *str, size_t str_len, char *dest, size_t dest_size, const char **ar, size_t ar_size, char delim) {
   // Validate inputs
   if (!str || !ar || !dest || ar_size == 0 || dest_size == 0) return NULL;  // Invalid inputs
 
-  size_t str_len = strlen(str);
-  const char *token = str;
-  size_t i = 0;
-  size_t ai = 0;
-  *ar = dest;
-  // Process tokens until end of string or array limit
-  while (*token && ai < ar_size) {
-    // Find next delimiter or end of string
-    *dest = *token;
-    token++;
-    dest++;
-    i++;
-    if (i == str_len) {
-      *dest = '\0';
-      return ar;
-    }
+  for (size_t i = 0; i < ar_size; i++) ar[i] = NULL;
 
-    if (*token == delim) {
-      *dest = '\0';
-      token++;
-      dest++;
-      i++;
-      ai++;
-      ar[ai] = dest;
-    } else if (*token == '\0') {
-      *dest = '\0';
-      return ar;
+  const char *end = str + str_len;
+  char *d = dest;
+  char *last = dest + dest_size - 1;  // Room for the final terminator
+  size_t ai = 0;
+  ar[ai] = d;
+  // Copy tokens until end of input, array limit or full destination
+  for (const char *p = str; p < end && *p && d < last; p++) {
+    if (*p != delim) {
+      *d++ = *p;
+      continue;
     }
+    if (ai + 1 >= ar_size) break;
+    *d++ = '\0';
+    ar[++ai] = d;
   }
+  *d = '\0';
   return ar;
 }
 
@@ -1412,6 +3175,111 @@ char *split_chr(const char *str, char *ar, size_t ar_size, char delim) {
   return ar;
 }
 
+char *split_chr(const char *str, size_t str_len, char *ar, size_t ar_size, char delim) {
+  // Validate inputs
+  if (!str || !ar || ar_size <= 1) {
+    return NULL;  // Invalid string, array, or size
+  }
+  if (str_len && *str == '[') {
+    str++;
+    str_len--;
+  }
+  // Copy non-delimiter characters
+  size_t pos = 0;
+  for (size_t i = 0; i < str_len && str[i] != '\0' && pos < ar_size - 1; i++) {
+    if (str[i] != delim) {
+      ar[pos++] = str[i];
+    }
+  }
+
+  // Ensure null termination
+  ar[pos] = '\0';
+
+  return pos ? ar : NULL;
+}
+
+#ifdef __AVR__
+#define SPLIT_TOKEN_MAX 48
+#else
+#define SPLIT_TOKEN_MAX 128
+#endif
+
+// Shared body of the length-bounded split_* overloads. The input may not be
+// terminated, so each token is parsed from a small terminated copy; the
+// conversion can then never read past str_len, and the input is not modified.
+template <typename T, typename F>
+static T *split_span(const char *str, size_t str_len, T *ar, size_t ar_size, char delim, F parse) {
+  // Validate inputs
+  if (!str || !ar || ar_size == 0) return NULL;
+
+  const char *end = str + str_len;
+  const char *token = str;
+  if (token < end && *token == '[') token++;
+  size_t i = 0;
+
+  while (token < end && *token && i < ar_size) {
+    const char *next = (const char *)memchr(token, delim, end - token);
+    size_t len = (next ? next : end) - token;
+    char temp[SPLIT_TOKEN_MAX];
+    if (len >= sizeof(temp)) return NULL;  // Too long to be a value
+    memcpy(temp, token, len);
+    temp[len] = '\0';
+
+    const char *endptr;
+    ar[i] = parse(temp, &endptr);
+    if (endptr == temp) return NULL;  // Invalid value
+    i++;
+    if (!next) break;
+    token = next + 1;
+  }
+
+  return i ? ar : NULL;
+}
+
+bool *split_bool(const char *str, size_t str_len, bool *ar, size_t ar_size, char delim, const char *t, const char *f) {
+  return split_span(str, str_len, ar, ar_size, delim, [t, f](const char *s, const char **e) { return str_to_bool(s, e, t, f); });
+}
+
+int8_t *split_i8(const char *str, size_t str_len, int8_t *ar, size_t ar_size, char delim) {
+  return split_span(str, str_len, ar, ar_size, delim, [](const char *s, const char **e) { return str_to_i8(s, e, 10); });
+}
+
+uint8_t *split_u8(const char *str, size_t str_len, uint8_t *ar, size_t ar_size, char delim) {
+  return split_span(str, str_len, ar, ar_size, delim, [](const char *s, const char **e) { return str_to_u8(s, e, 10); });
+}
+
+int16_t *split_i16(const char *str, size_t str_len, int16_t *ar, size_t ar_size, char delim) {
+  return split_span(str, str_len, ar, ar_size, delim, [](const char *s, const char **e) { return str_to_i16(s, e, 10); });
+}
+
+uint16_t *split_u16(const char *str, size_t str_len, uint16_t *ar, size_t ar_size, char delim) {
+  return split_span(str, str_len, ar, ar_size, delim, [](const char *s, const char **e) { return str_to_u16(s, e, 10); });
+}
+
+int32_t *split_i32(const char *str, size_t str_len, int32_t *ar, size_t ar_size, char delim) {
+  return split_span(str, str_len, ar, ar_size, delim, [](const char *s, const char **e) { return str_to_i32(s, e, 10); });
+}
+
+uint32_t *split_u32(const char *str, size_t str_len, uint32_t *ar, size_t ar_size, char delim) {
+  return split_span(str, str_len, ar, ar_size, delim, [](const char *s, const char **e) { return str_to_u32(s, e, 10); });
+}
+
+int64_t *split_i64(const char *str, size_t str_len, int64_t *ar, size_t ar_size, char delim) {
+  return split_span(str, str_len, ar, ar_size, delim, [](const char *s, const char **e) { return str_to_i64(s, e, 10); });
+}
+
+uint64_t *split_u64(const char *str, size_t str_len, uint64_t *ar, size_t ar_size, char delim) {
+  return split_span(str, str_len, ar, ar_size, delim, [](const char *s, const char **e) { return str_to_u64(s, e, 10); });
+}
+
+float *split_float(const char *str, size_t str_len, float *ar, size_t ar_size, char d, char delim) {
+  return split_span(str, str_len, ar, ar_size, delim, [d](const char *s, const char **e) { return (float)str_to_double(s, d, e); });
+}
+
+double *split_double(const char *str, size_t str_len, double *ar, size_t ar_size, char d, char delim) {
+  return split_span(str, str_len, ar, ar_size, delim, [d](const char *s, const char **e) { return str_to_double(s, d, e); });
+}
+
 int8_t *split_i8(const char *str, int8_t *ar, size_t ar_size, char delim) {
   // Validate inputs
   if (!str || !ar || ar_size == 0) {
@@ -1822,80 +3690,1262 @@ double *split_double(const char *str, double *ar, size_t ar_size, char d, char d
   return ar;
 }
 
-bool is_number(const char *str, size_t len) {
-  if (!str || len == 0) return false;
-
-  size_t i = 0;
+// Varints (LEB128) store 7 bits per byte, low group first, with the top bit
+// set on every byte but the last. Signed values are zigzag-encoded first.
+template <typename U>
+static size_t varint_put(U v, uint8_t *buf, size_t buf_size) {
+  size_t n = 0;
+  while (v >= 0x80) {
+    if (n == buf_size) return 0;
+    buf[n++] = (uint8_t)v | 0x80;
+    v >>= 7;
+  }
+  if (n == buf_size) return 0;
+  buf[n++] = (uint8_t)v;
+  return n;
+}
 
-  if (str[i] == '+' || str[i] == '-') {
-    i++;
-    if (i == len) return false;
+// Byte-at-a-time varint decoder; returns the length, or 0 if the varint is
+// truncated, longer than U allows or out of range for U
+template <typename U>
+static uint8_t varint_get_bytes(const uint8_t *p, size_t len, U *out) {
+  const uint8_t max = (sizeof(U) * 8 + 6) / 7;
+  U v = 0;
+  for (uint8_t i = 0; i < max && i < len; i++) {
+    U part = p[i] & 0x7F;
+    uint8_t shift = i * 7;
+    // Only the last allowed byte can carry bits beyond the width of U
+    if (i == max - 1 && (part >> (sizeof(U) * 8 - shift))) return 0;
+    v |= (U)(part << shift);
+    if (!(p[i] & 0x80)) {
+      *out = v;
+      return i + 1;
+    }
   }
+  return 0;
+}
 
-  bool has_digit = false;
-
-  for (; i < len; i++) {
-    if (!isdigit((unsigned char)str[i])) {
-      return false;
+template <typename U>
+static inline uint8_t varint_get(const uint8_t *p, size_t len, U *out) {
+#ifndef __AVR__
+  if (len >= 8) {
+    // Up to 8 bytes at once: the first clear top bit ends the value, then the
+    // 7-bit groups are packed together without a per-byte branch
+    uint64_t w = load_le64(p);
+    uint64_t stop = ~w & 0x8080808080808080ULL;
+    if (stop) {
+      uint8_t last = bitCtz(stop);
+      uint8_t n = last / 8 + 1;
+      uint64_t x = w & (~0ULL >> (63 - last)) & 0x7F7F7F7F7F7F7F7FULL;
+      x = (x & 0x007F007F007F007FULL) | ((x & 0x7F007F007F007F00ULL) >> 1);
+      x = (x & 0x00003FFF00003FFFULL) | ((x & 0x3FFF00003FFF0000ULL) >> 2);
+      x = (x & 0x000000000FFFFFFFULL) | ((x & 0x0FFFFFFF00000000ULL) >> 4);
+      if (n > (sizeof(U) * 8 + 6) / 7 || x > (U)~(U)0) return 0;
+      *out = (U)x;
+      return n;
     }
-    has_digit = true;
   }
+#endif
+  return varint_get_bytes(p, len, out);
+}
 
-  return has_digit;
+template <typename T, typename U>
+static T varint_read(const uint8_t *buf, size_t len, const uint8_t **endptr, bool zigzag) {
+  U v = 0;
+  uint8_t n = buf ? varint_get(buf, len, &v) : 0;
+  if (endptr) *endptr = buf + n;
+  if (!n) return 0;
+  return zigzag ? (T)(sizeof(U) == 8 ? unzigzag64(v) : unzigzag32(v)) : (T)v;
 }
 
-const char *str_end(const char *str) {
-  if (!str) return NULL;
-  const char *p = str;
-  bool instr = false;
-  while (*p) {
-    if (*p == '\\' && p[1] == '"') {
-      p++;
-    } else {
-      if (*p == '"') {
-        if (!instr) {
-          instr = true;
-          p++;
-        } else {
-          p++;
-          return p;
-        }
-      }
-    }
-    p++;
+template <typename T, typename U>
+static size_t varint_join(const T *ar, size_t ar_size, uint8_t *buf, size_t buf_size, bool zigzag) {
+  if (!ar || !buf || ar_size == 0) return 0;
+  size_t pos = 0;
+  for (size_t i = 0; i < ar_size; i++) {
+    U v = zigzag ? (U)(sizeof(U) == 8 ? zigzag64(ar[i]) : zigzag32(ar[i])) : (U)ar[i];
+    size_t n = varint_put(v, buf + pos, buf_size - pos);
+    if (!n) return 0;
+    pos += n;
   }
-  return NULL;
+  return pos;
 }
 
-const char *str_ignore(const char *str) {
-  if (!str) return NULL;
-  const char *p = str;
-  while (*p && (*p == ' ' || *p == '\r' || *p == '\n' || *p == '\t')) p++;
-  return p;
+template <typename T, typename U>
+static size_t varint_split(const uint8_t *buf, size_t len, T *ar, size_t ar_size, bool zigzag) {
+  if (!buf || !ar || ar_size == 0) return 0;
+  size_t pos = 0;
+  size_t i = 0;
+  while (pos < len && i < ar_size) {
+    U v;
+    uint8_t n = varint_get(buf + pos, len - pos, &v);
+    if (!n) return 0;
+    ar[i++] = zigzag ? (T)(sizeof(U) == 8 ? unzigzag64(v) : unzigzag32(v)) : (T)v;
+    pos += n;
+  }
+  return i;
 }
 
-const char *br_end(const char *str) {
-  if (!str) return NULL;
-  size_t level = 0;
-  const char *p = str_ignore(str);
-  while (*p) {
-    if (*p == '[' || *p == '{') {
-      level++;
-    } else if (*p == ']' || *p == '}') {
-      level--;
-      if (level == 0) return p;
-    }
-    p++;
-  }
-  return NULL;
+size_t u8_to_varint(uint8_t num, uint8_t *buf, size_t buf_size) {
+  if (!buf) return 0;
+  return varint_put(num, buf, buf_size);
 }
 
-const char *coma_end(const char *str) {
-  if (!str) return NULL;
-  const char *p = str;
-  while (*p) {
-    if (*p == ',' || *p == '}' || *p == ']') return p;
-    p++;
-  }
-  return NULL;
-}
\ No newline at end of file
+size_t i8_to_varint(int8_t num, uint8_t *buf, size_t buf_size) {
+  if (!buf) return 0;
+  return varint_put((uint8_t)zigzag32(num), buf, buf_size);
+}
+
+size_t u16_to_varint(uint16_t num, uint8_t *buf, size_t buf_size) {
+  if (!buf) return 0;
+  return varint_put(num, buf, buf_size);
+}
+
+size_t i16_to_varint(int16_t num, uint8_t *buf, size_t buf_size) {
+  if (!buf) return 0;
+  return varint_put((uint16_t)zigzag32(num), buf, buf_size);
+}
+
+size_t u32_to_varint(uint32_t num, uint8_t *buf, size_t buf_size) {
+  if (!buf) return 0;
+  return varint_put(num, buf, buf_size);
+}
+
+size_t i32_to_varint(int32_t num, uint8_t *buf, size_t buf_size) {
+  if (!buf) return 0;
+  return varint_put((uint32_t)zigzag32(num), buf, buf_size);
+}
+
+size_t u64_to_varint(uint64_t num, uint8_t *buf, size_t buf_size) {
+  if (!buf) return 0;
+  return varint_put(num, buf, buf_size);
+}
+
+size_t i64_to_varint(int64_t num, uint8_t *buf, size_t buf_size) {
+  if (!buf) return 0;
+  return varint_put((uint64_t)zigzag64(num), buf, buf_size);
+}
+
+uint8_t varint_to_u8(const uint8_t *buf, size_t len, const uint8_t **endptr) {
+  return varint_read<uint8_t, uint8_t>(buf, len, endptr, false);
+}
+
+int8_t varint_to_i8(const uint8_t *buf, size_t len, const uint8_t **endptr) {
+  return varint_read<int8_t, uint8_t>(buf, len, endptr, true);
+}
+
+uint16_t varint_to_u16(const uint8_t *buf, size_t len, const uint8_t **endptr) {
+  return varint_read<uint16_t, uint16_t>(buf, len, endptr, false);
+}
+
+int16_t varint_to_i16(const uint8_t *buf, size_t len, const uint8_t **endptr) {
+  return varint_read<int16_t, uint16_t>(buf, len, endptr, true);
+}
+
+uint32_t varint_to_u32(const uint8_t *buf, size_t len, const uint8_t **endptr) {
+  return varint_read<uint32_t, uint32_t>(buf, len, endptr, false);
+}
+
+int32_t varint_to_i32(const uint8_t *buf, size_t len, const uint8_t **endptr) {
+  return varint_read<int32_t, uint32_t>(buf, len, endptr, true);
+}
+
+uint64_t varint_to_u64(const uint8_t *buf, size_t len, const uint8_t **endptr) {
+  return varint_read<uint64_t, uint64_t>(buf, len, endptr, false);
+}
+
+int64_t varint_to_i64(const uint8_t *buf, size_t len, const uint8_t **endptr) {
+  return varint_read<int64_t, uint64_t>(buf, len, endptr, true);
+}
+
+size_t join_varint_u8(const uint8_t *ar, size_t ar_size, uint8_t *buf, size_t buf_size) {
+  return varint_join<uint8_t, uint8_t>(ar, ar_size, buf, buf_size, false);
+}
+
+size_t join_varint_i8(const int8_t *ar, size_t ar_size, uint8_t *buf, size_t buf_size) {
+  return varint_join<int8_t, uint8_t>(ar, ar_size, buf, buf_size, true);
+}
+
+size_t join_varint_u16(const uint16_t *ar, size_t ar_size, uint8_t *buf, size_t buf_size) {
+  return varint_join<uint16_t, uint16_t>(ar, ar_size, buf, buf_size, false);
+}
+
+size_t join_varint_i16(const int16_t *ar, size_t ar_size, uint8_t *buf, size_t buf_size) {
+  return varint_join<int16_t, uint16_t>(ar, ar_size, buf, buf_size, true);
+}
+
+size_t join_varint_u32(const uint32_t *ar, size_t ar_size, uint8_t *buf, size_t buf_size) {
+  return varint_join<uint32_t, uint32_t>(ar, ar_size, buf, buf_size, false);
+}
+
+size_t join_varint_i32(const int32_t *ar, size_t ar_size, uint8_t *buf, size_t buf_size) {
+  return varint_join<int32_t, uint32_t>(ar, ar_size, buf, buf_size, true);
+}
+
+size_t join_varint_u64(const uint64_t *ar, size_t ar_size, uint8_t *buf, size_t buf_size) {
+  return varint_join<uint64_t, uint64_t>(ar, ar_size, buf, buf_size, false);
+}
+
+size_t join_varint_i64(const int64_t *ar, size_t ar_size, uint8_t *buf, size_t buf_size) {
+  return varint_join<int64_t, uint64_t>(ar, ar_size, buf, buf_size, true);
+}
+
+size_t split_varint_u8(const uint8_t *buf, size_t len, uint8_t *ar, size_t ar_size) {
+  return varint_split<uint8_t, uint8_t>(buf, len, ar, ar_size, false);
+}
+
+size_t split_varint_i8(const uint8_t *buf, size_t len, int8_t *ar, size_t ar_size) {
+  return varint_split<int8_t, uint8_t>(buf, len, ar, ar_size, true);
+}
+
+size_t split_varint_u16(const uint8_t *buf, size_t len, uint16_t *ar, size_t ar_size) {
+  return varint_split<uint16_t, uint16_t>(buf, len, ar, ar_size, false);
+}
+
+size_t split_varint_i16(const uint8_t *buf, size_t len, int16_t *ar, size_t ar_size) {
+  return varint_split<int16_t, uint16_t>(buf, len, ar, ar_size, true);
+}
+
+size_t split_varint_u32(const uint8_t *buf, size_t len, uint32_t *ar, size_t ar_size) {
+  return varint_split<uint32_t, uint32_t>(buf, len, ar, ar_size, false);
+}
+
+size_t split_varint_i32(const uint8_t *buf, size_t len, int32_t *ar, size_t ar_size) {
+  return varint_split<int32_t, uint32_t>(buf, len, ar, ar_size, true);
+}
+
+size_t split_varint_u64(const uint8_t *buf, size_t len, uint64_t *ar, size_t ar_size) {
+  return varint_split<uint64_t, uint64_t>(buf, len, ar, ar_size, false);
+}
+
+size_t split_varint_i64(const uint8_t *buf, size_t len, int64_t *ar, size_t ar_size) {
+  return varint_split<int64_t, uint64_t>(buf, len, ar, ar_size, true);
+}
+
+// Packed blocks: a count byte (1-128), a width byte, the first value as a
+// varint and, after it, the minimum delta as a zigzag varint. The deltas minus
+// that minimum follow bit-packed LSB-first in groups of 32, so each whole group
+// is exactly 4 * width bytes; the last group of a block is cut to the bytes it
+// needs.
+#define PACK_GROUP 32
+
+template <typename U, typename S>
+static inline U pack_zigzag(U v) {
+  return (U)(sizeof(U) == 8 ? zigzag64((S)v) : zigzag32((S)v));
+}
+
+template <typename U>
+static inline U pack_unzigzag(U v) {
+  return (U)(sizeof(U) == 8 ? unzigzag64(v) : unzigzag32(v));
+}
+
+#ifndef __AVR__
+// Unrolled unpacker for one group of 32 fields of W bits from W little-endian words
+template <uint8_t W, uint8_t I>
+struct pack_lane {
+  static inline void get(const uint32_t *w, uint32_t *out) {
+    const uint16_t bit = I * W;
+    uint32_t v = w[bit / 32] >> (bit % 32);
+    if (bit % 32 + W > 32) v |= w[bit / 32 + 1] << (32 - bit % 32);
+    out[I] = v & bitMask<uint32_t>(W);
+    pack_lane<W, I + 1>::get(w, out);
+  }
+};
+
+template <uint8_t W>
+struct pack_lane<W, PACK_GROUP> {
+  static inline void get(const uint32_t *, uint32_t *) {}
+};
+
+template <uint8_t W>
+static void pack_unpack32(const uint32_t *w, uint32_t *out) {
+  pack_lane<W, 0>::get(w, out);
+}
+
+#define PACK_UNPACK4(w) pack_unpack32<w>, pack_unpack32<w + 1>, pack_unpack32<w + 2>, pack_unpack32<w + 3>
+static void (*const pack_unpackers[33])(const uint32_t *, uint32_t *) = {
+    PACK_UNPACK4(0),  PACK_UNPACK4(4),  PACK_UNPACK4(8),  PACK_UNPACK4(12), PACK_UNPACK4(16),
+    PACK_UNPACK4(20), PACK_UNPACK4(24), PACK_UNPACK4(28), pack_unpack32<32>};
+#undef PACK_UNPACK4
+#endif
+
+// Bytes taken by k fields of the given width
+static inline size_t pack_bytes(uint8_t k, uint8_t width) {
+  return ((size_t)k * width + 7) / 8;
+}
+
+// Unpacks k (at most 32) fields of the given width from pack_bytes(k, width) bytes
+static inline void pack_unpack(const uint8_t *p, uint8_t width, uint8_t k, uint32_t *out) {
+#ifndef __AVR__
+  uint32_t w[32];
+  if (k == PACK_GROUP) {
+    load_le32_arr(w, p, width);
+  } else {
+    // A short last group goes through a zeroed scratch group
+    uint8_t scratch[PACK_GROUP * 4] = {0};
+    memcpy(scratch, p, pack_bytes(k, width));
+    load_le32_arr(w, scratch, width);
+  }
+  pack_unpackers[width](w, out);
+#else
+  bit_reader br;
+  bit_reader_init(&br, p, pack_bytes(k, width), true);
+  for (uint8_t i = 0; i < k; i++) out[i] = width ? bit_read(&br, width) : 0;
+#endif
+}
+
+static inline void pack_unpack(const uint8_t *p, uint8_t width, uint8_t k, uint64_t *out) {
+  bit_reader br;
+  bit_reader_init(&br, p, pack_bytes(k, width), true);
+  for (uint8_t i = 0; i < k; i++) {
+    if (width <= 32) {
+      out[i] = width ? bit_read(&br, width) : 0;
+    } else {
+      uint64_t lo = bit_read(&br, 32);
+      out[i] = lo | (uint64_t)bit_read(&br, width - 32) << 32;
+    }
+  }
+}
+
+template <typename T, typename U, typename S>
+static size_t packed_join(const T *ar, size_t ar_size, uint8_t *buf, size_t buf_size, uint8_t block) {
+  if (!ar || !buf || ar_size == 0 || (block != 32 && block != 128)) return 0;
+  const bool zigzag = (T)-1 < 0;
+  size_t pos = 0;
+  for (size_t start = 0; start < ar_size; start += block) {
+    uint8_t n = ar_size - start < block ? (uint8_t)(ar_size - start) : block;
+    const T *v = ar + start;
+
+    // Frame of reference: the smallest delta, compared as signed
+    U min = 0;
+    if (n > 1) min = (U)((U)v[1] - (U)v[0]);
+    for (uint8_t i = 2; i < n; i++) {
+      U d = (U)((U)v[i] - (U)v[i - 1]);
+      if ((S)d < (S)min) min = d;
+    }
+    U all = 0;
+    for (uint8_t i = 1; i < n; i++) all |= (U)((U)((U)v[i] - (U)v[i - 1]) - min);
+    uint8_t width = sizeof(U) * 8 - bitClz(all);
+
+    if (buf_size - pos < 2) return 0;
+    buf[pos++] = n;
+    buf[pos++] = width;
+    U first = zigzag ? pack_zigzag<U, S>((U)v[0]) : (U)v[0];
+    size_t len = varint_put(first, buf + pos, buf_size - pos);
+    if (!len) return 0;
+    pos += len;
+    if (n == 1) continue;
+    len = varint_put(pack_zigzag<U, S>(min), buf + pos, buf_size - pos);
+    if (!len) return 0;
+    pos += len;
+    if (width == 0) continue;
+
+    // Deltas as one bit stream: whole groups of 32 stay byte aligned and the
+    // last one ends at the next byte boundary
+    bit_writer bw;
+    bit_writer_init(&bw, buf + pos, buf_size - pos, true);
+    for (uint8_t i = 1; i < n; i++) {
+      U f = (U)((U)((U)v[i] - (U)v[i - 1]) - min);
+      if (width <= 32) {
+        bit_write(&bw, (uint32_t)f, width);
+      } else {
+        bit_write(&bw, (uint32_t)f, 32);
+        bit_write(&bw, (uint32_t)((uint64_t)f >> 32), width - 32);
+      }
+    }
+    len = bit_flush(&bw);
+    if (!len) return 0;
+    pos += len;
+  }
+  return pos;
+}
+
+template <typename T, typename U, typename L>
+static size_t packed_split(const uint8_t *buf, size_t len, T *ar, size_t ar_size) {
+  if (!buf || !ar || ar_size == 0) return 0;
+  const bool zigzag = (T)-1 < 0;
+  size_t pos = 0;
+  size_t count = 0;
+  L f[PACK_GROUP];
+  while (pos < len && count < ar_size) {
+    if (len - pos < 2) return 0;
+    uint8_t n = buf[pos++];
+    uint8_t width = buf[pos++];
+    if (n == 0 || n > 128 || width > sizeof(U) * 8) return 0;
+    U v;
+    uint8_t vlen = varint_get(buf + pos, len - pos, &v);
+    if (!vlen) return 0;
+    pos += vlen;
+    if (zigzag) v = pack_unzigzag(v);
+    ar[count++] = (T)v;
+    if (n == 1) continue;
+    U min;
+    vlen = varint_get(buf + pos, len - pos, &min);
+    if (!vlen) return 0;
+    pos += vlen;
+    min = pack_unzigzag(min);
+
+    if (pack_bytes(n - 1, width) > len - pos) return 0;
+    for (uint8_t i = 1; i < n && count < ar_size;) {
+      uint8_t k = n - i < PACK_GROUP ? (uint8_t)(n - i) : PACK_GROUP;
+      if (width) {
+        pack_unpack(buf + pos, width, k, f);
+        pos += pack_bytes(k, width);
+      } else {
+        memset(f, 0, sizeof(f));
+      }
+      uint8_t end = i + k;
+      if ((size_t)(end - i) > ar_size - count) end = (uint8_t)(i + (ar_size - count));
+      for (uint8_t j = 0; i < end; i++, j++) {
+        v = (U)(v + min + (U)f[j]);
+        ar[count++] = (T)v;
+      }
+    }
+    // A full array ends decoding, possibly in the middle of a block
+    if (count == ar_size) break;
+  }
+  return count;
+}
+
+size_t join_packed_u8(const uint8_t *ar, size_t ar_size, uint8_t *buf, size_t buf_size, uint8_t block) {
+  return packed_join<uint8_t, uint8_t, int8_t>(ar, ar_size, buf, buf_size, block);
+}
+
+size_t join_packed_i8(const int8_t *ar, size_t ar_size, uint8_t *buf, size_t buf_size, uint8_t block) {
+  return packed_join<int8_t, uint8_t, int8_t>(ar, ar_size, buf, buf_size, block);
+}
+
+size_t join_packed_u16(const uint16_t *ar, size_t ar_size, uint8_t *buf, size_t buf_size, uint8_t block) {
+  return packed_join<uint16_t, uint16_t, int16_t>(ar, ar_size, buf, buf_size, block);
+}
+
+size_t join_packed_i16(const int16_t *ar, size_t ar_size, uint8_t *buf, size_t buf_size, uint8_t block) {
+  return packed_join<int16_t, uint16_t, int16_t>(ar, ar_size, buf, buf_size, block);
+}
+
+size_t join_packed_u32(const uint32_t *ar, size_t ar_size, uint8_t *buf, size_t buf_size, uint8_t block) {
+  return packed_join<uint32_t, uint32_t, int32_t>(ar, ar_size, buf, buf_size, block);
+}
+
+size_t join_packed_i32(const int32_t *ar, size_t ar_size, uint8_t *buf, size_t buf_size, uint8_t block) {
+  return packed_join<int32_t, uint32_t, int32_t>(ar, ar_size, buf, buf_size, block);
+}
+
+size_t join_packed_u64(const uint64_t *ar, size_t ar_size, uint8_t *buf, size_t buf_size, uint8_t block) {
+  return packed_join<uint64_t, uint64_t, int64_t>(ar, ar_size, buf, buf_size, block);
+}
+
+size_t join_packed_i64(const int64_t *ar, size_t ar_size, uint8_t *buf, size_t buf_size, uint8_t block) {
+  return packed_join<int64_t, uint64_t, int64_t>(ar, ar_size, buf, buf_size, block);
+}
+
+size_t split_packed_u8(const uint8_t *buf, size_t len, uint8_t *ar, size_t ar_size) {
+  return packed_split<uint8_t, uint8_t, uint32_t>(buf, len, ar, ar_size);
+}
+
+size_t split_packed_i8(const uint8_t *buf, size_t len, int8_t *ar, size_t ar_size) {
+  return packed_split<int8_t, uint8_t, uint32_t>(buf, len, ar, ar_size);
+}
+
+size_t split_packed_u16(const uint8_t *buf, size_t len, uint16_t *ar, size_t ar_size) {
+  return packed_split<uint16_t, uint16_t, uint32_t>(buf, len, ar, ar_size);
+}
+
+size_t split_packed_i16(const uint8_t *buf, size_t len, int16_t *ar, size_t ar_size) {
+  return packed_split<int16_t, uint16_t, uint32_t>(buf, len, ar, ar_size);
+}
+
+size_t split_packed_u32(const uint8_t *buf, size_t len, uint32_t *ar, size_t ar_size) {
+  return packed_split<uint32_t, uint32_t, uint32_t>(buf, len, ar, ar_size);
+}
+
+size_t split_packed_i32(const uint8_t *buf, size_t len, int32_t *ar, size_t ar_size) {
+  return packed_split<int32_t, uint32_t, uint32_t>(buf, len, ar, ar_size);
+}
+
+size_t split_packed_u64(const uint8_t *buf, size_t len, uint64_t *ar, size_t ar_size) {
+  return packed_split<uint64_t, uint64_t, uint64_t>(buf, len, ar, ar_size);
+}
+
+size_t split_packed_i64(const uint8_t *buf, size_t len, int64_t *ar, size_t ar_size) {
+  return packed_split<int64_t, uint64_t, uint64_t>(buf, len, ar, ar_size);
+}
+
+// Length of the run of ASCII digits at the start of [p, p + n)
+static size_t digit_run(const char *p, size_t n) {
+  size_t i = 0;
+#if defined(__SSE2__)
+  const __m128i nine = _mm_set1_epi8(9);
+  for (; i + 16 <= n; i += 16) {
+    __m128i v = _mm_sub_epi8(_mm_loadu_si128((const __m128i *)(p + i)), _mm_set1_epi8('0'));
+    uint32_t digit = (uint32_t)_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_max_epu8(v, nine), nine));
+    if (digit != 0xFFFF) return i + __builtin_ctz(~digit);
+  }
+#endif
+  for (; i + sizeof(swar_t) <= n; i += sizeof(swar_t)) {
+    if (swar_nondigit(swar_load(p + i))) break;
+  }
+  while (i < n && p[i] >= '0' && p[i] <= '9') i++;
+  return i;
+}
+
+static inline bool chr_ieq(char c, char lower) {
+  return (c | 0x20) == lower;
+}
+
+// Case-insensitive match of the lower-case word w against [p, p + n)
+static bool word_ieq(const char *p, size_t n, const char *w) {
+  size_t i = 0;
+  for (; w[i]; i++) {
+    if (i == n || !chr_ieq(p[i], w[i])) return false;
+  }
+  return i == n;
+}
+
+bool is_number(const char *str, size_t len) {
+  if (!str || len == 0) return false;
+
+  size_t i = 0;
+
+  if (str[i] == '+' || str[i] == '-') {
+    i++;
+    if (i == len) return false;
+  }
+
+  return digit_run(str + i, len - i) == len - i;
+}
+
+num_kind num_classify(const char *str, size_t len, size_t *digits, char d) {
+  if (digits) *digits = 0;
+  if (!str || len == 0) return NUM_INVALID;
+
+  const char *p = str;
+  const char *end = str + len;
+  if (*p == '+' || *p == '-') p++;
+  size_t n = end - p;
+  if (n == 0) return NUM_INVALID;
+
+  // Hexadecimal: 0x followed by at least one hex digit
+  if (n > 2 && p[0] == '0' && chr_ieq(p[1], 'x')) {
+    for (size_t i = 2; i < n; i++) {
+      if (hex_val(p[i]) < 0) return NUM_INVALID;
+    }
+    if (digits) *digits = n - 2;
+    return NUM_HEX;
+  }
+
+  // Words
+  if (!(*p >= '0' && *p <= '9') && *p != d) {
+    if (word_ieq(p, n, "inf") || word_ieq(p, n, "infinity")) return NUM_INF;
+    if (word_ieq(p, n, "nan")) return NUM_NAN;
+    return NUM_INVALID;
+  }
+
+  // Mantissa: digits [d digits], at least one digit in total
+  num_kind kind = NUM_INT;
+  size_t count = digit_run(p, end - p);
+  p += count;
+  if (p < end && *p == d) {
+    kind = NUM_DEC;
+    size_t frac = digit_run(p + 1, end - p - 1);
+    count += frac;
+    p += 1 + frac;
+  }
+  if (count == 0) return NUM_INVALID;
+
+  // Exponent: e [sign] digits
+  if (p < end && chr_ieq(*p, 'e')) {
+    p++;
+    if (p < end && (*p == '+' || *p == '-')) p++;
+    size_t exp = digit_run(p, end - p);
+    if (exp == 0) return NUM_INVALID;
+    p += exp;
+    kind = NUM_EXP;
+  }
+  if (p != end) return NUM_INVALID;
+
+  if (digits) *digits = count;
+  return kind;
+}
+
+const char *str_end(const char *str) {
+  if (!str) return NULL;
+  const char *p = str;
+  bool instr = false;
+  while (*p) {
+    if (*p == '\\' && p[1]) {
+      p++;  // Skip the escaped character
+    } else {
+      if (*p == '"') {
+        if (!instr) {
+          instr = true;
+        } else {
+          p++;
+          return p;
+        }
+      }
+    }
+    p++;
+  }
+  return NULL;
+}
+
+const char *str_ignore(const char *str) {
+  if (!str) return NULL;
+  const char *p = str;
+  while (*p && (*p == ' ' || *p == '\r' || *p == '\n' || *p == '\t')) p++;
+  return p;
+}
+
+const char *str_ignore(const char *str, size_t str_len) {
+  if (!str) return NULL;
+  const char *p = str;
+  const char *end = str + str_len;
+  while (p < end && (*p == ' ' || *p == '\r' || *p == '\n' || *p == '\t')) p++;
+  return p;
+}
+
+const char *br_end(const char *str) {
+  if (!str) return NULL;
+  size_t level = 0;
+  bool instr = false;
+  const char *p = str_ignore(str);
+  while (*p) {
+    if (*p == '\\' && p[1]) {
+      p++;  // Skip the escaped character
+    } else if (*p == '"') {
+      instr = !instr;
+    } else if (instr) {
+      // Brackets inside strings do not count
+    } else if (*p == '[' || *p == '{') {
+      level++;
+    } else if (*p == ']' || *p == '}') {
+      level--;
+      if (level == 0) return p;
+    }
+    p++;
+  }
+  return NULL;
+}
+
+const char *coma_end(const char *str) {
+  if (!str) return NULL;
+  const char *p = str;
+  while (*p) {
+    if (*p == ',' || *p == '}' || *p == ']') return p;
+    p++;
+  }
+  return NULL;
+}
+
+// Returns the first character after the JSON value starting at p
+static const char *json_skip(const char *p) {
+  if (*p == '"') return str_end(p);
+  if (*p == '[' || *p == '{') {
+    const char *e = br_end(p);
+    return e ? e + 1 : NULL;
+  }
+  const char *e = coma_end(p);
+  return e ? e : p + strlen(p);
+}
+
+const char *json_path(const char *str, const char *path, size_t *len) {
+  if (!str || !path) return NULL;
+
+  const char *p = str_ignore(str);
+  while (*path) {
+    if (*path == '.') path++;
+
+    if (*path == '[') {
+      // Array element: skip n siblings without looking inside them
+      const char *endptr;
+      uint32_t n = str_to_u32(path + 1, &endptr);
+      if (endptr == path + 1 || *endptr != ']' || *p != '[') return NULL;
+      path = endptr + 1;
+
+      p = str_ignore(p + 1);
+      for (; n > 0; n--) {
+        if (*p == ']' || !(p = json_skip(p))) return NULL;
+        p = str_ignore(p);
+        if (*p != ',') return NULL;
+        p = str_ignore(p + 1);
+      }
+      if (*p == ']' || !*p) return NULL;
+    } else {
+      // Object member: compare keys, skip the values of the others
+      const char *key = path;
+      while (*path && *path != '.' && *path != '[') path++;
+      size_t key_len = path - key;
+      if (*p != '{') return NULL;
+
+      p = str_ignore(p + 1);
+      while (true) {
+        if (*p != '"') return NULL;  // '}' (key not found) or malformed
+        const char *k = p;
+        if (!(p = str_end(p))) return NULL;
+        bool found = (size_t)(p - k - 2) == key_len && !memcmp(k + 1, key, key_len);
+
+        p = str_ignore(p);
+        if (*p != ':') return NULL;
+        p = str_ignore(p + 1);
+        if (found) break;
+
+        if (!(p = json_skip(p))) return NULL;
+        p = str_ignore(p);
+        if (*p != ',') return NULL;
+        p = str_ignore(p + 1);
+      }
+    }
+  }
+
+  // p is at the target value, find its extent
+  const char *end = json_skip(p);
+  if (!end || end == p) return NULL;
+  while (end > p && (end[-1] == ' ' || end[-1] == '\r' || end[-1] == '\n' || end[-1] == '\t')) end--;
+  if (len) *len = end - p;
+  return p;
+}
+
+void json_stream_reset(json_stream *st) {
+  if (!st) return;
+  memset(st, 0, sizeof(*st));
+}
+
+const char *json_stream_end(json_stream *st, const char *buf, size_t len) {
+  if (!st || !buf || st->error) return NULL;
+
+  size_t i = st->pos;
+  for (; i < len; i++) {
+    char c = buf[i];
+    if (st->instr) {
+      if (st->escape) {
+        st->escape = false;
+      } else if (c == '\\') {
+        st->escape = true;
+      } else if (c == '"') {
+        st->instr = false;
+        if (st->level == 0) break;  // Top-level string complete
+      }
+    } else if (c == '"') {
+      st->instr = true;
+      st->started = true;
+    } else if (c == '[' || c == '{') {
+      if (st->level == UINT16_MAX) {
+        st->error = true;
+        return NULL;
+      }
+      st->level++;
+      st->started = true;
+    } else if (c == ']' || c == '}') {
+      if (st->level == 0) {
+        st->error = true;  // Unbalanced
+        return NULL;
+      }
+      if (--st->level == 0) break;  // Top-level container complete
+    } else if (!st->started && c != ' ' && c != '\r' && c != '\n' && c != '\t') {
+      st->error = true;  // Scalars cannot be delimited at the top level
+      return NULL;
+    }
+  }
+
+  if (i == len) {
+    st->pos = len;
+    return NULL;  // Need more bytes
+  }
+  st->pos = i + 1;
+  return buf + i + 1;
+}
+
+// One-pass array reader shared by the json_arr_* functions. parse(p, &e) reads
+// one element at p and sets e past it (e == p on failure). Elements beyond
+// ar_size are parsed and counted but not stored.
+template <typename T, typename F>
+static size_t json_arr_parse(const char *str, T *ar, size_t ar_size, const char **endptr, F parse) {
+  if (endptr) *endptr = str;
+  if (!str || !ar) return 0;
+
+  const char *p = str_ignore(str);
+  if (*p != '[') return 0;
+  p = str_ignore(p + 1);
+
+  size_t count = 0;
+  if (*p != ']') {
+    while (true) {
+      const char *e;
+      T v = parse(p, &e);
+      if (e == p) return 0;  // Invalid element
+      if (count < ar_size) ar[count] = v;
+      count++;
+
+      p = str_ignore(e);
+      if (*p == ']') break;
+      if (*p != ',') return 0;  // Missing delimiter or truncated array
+      p = str_ignore(p + 1);
+    }
+  }
+
+  if (endptr) *endptr = p + 1;
+  return count;
+}
+
+size_t json_arr_bool(const char *str, bool *ar, size_t ar_size, const char **endptr) {
+  return json_arr_parse(str, ar, ar_size, endptr, [](const char *s, const char **e) { return str_to_bool(s, e); });
+}
+
+size_t json_arr_i8(const char *str, int8_t *ar, size_t ar_size, const char **endptr) {
+  return json_arr_parse(str, ar, ar_size, endptr, [](const char *s, const char **e) { return str_to_i8(s, e); });
+}
+
+size_t json_arr_u8(const char *str, uint8_t *ar, size_t ar_size, const char **endptr) {
+  return json_arr_parse(str, ar, ar_size, endptr, [](const char *s, const char **e) { return str_to_u8(s, e); });
+}
+
+size_t json_arr_i16(const char *str, int16_t *ar, size_t ar_size, const char **endptr) {
+  return json_arr_parse(str, ar, ar_size, endptr, [](const char *s, const char **e) { return str_to_i16(s, e); });
+}
+
+size_t json_arr_u16(const char *str, uint16_t *ar, size_t ar_size, const char **endptr) {
+  return json_arr_parse(str, ar, ar_size, endptr, [](const char *s, const char **e) { return str_to_u16(s, e); });
+}
+
+size_t json_arr_i32(const char *str, int32_t *ar, size_t ar_size, const char **endptr) {
+  return json_arr_parse(str, ar, ar_size, endptr, [](const char *s, const char **e) { return str_to_i32(s, e); });
+}
+
+size_t json_arr_u32(const char *str, uint32_t *ar, size_t ar_size, const char **endptr) {
+  return json_arr_parse(str, ar, ar_size, endptr, [](const char *s, const char **e) { return str_to_u32(s, e); });
+}
+
+size_t json_arr_i64(const char *str, int64_t *ar, size_t ar_size, const char **endptr) {
+  return json_arr_parse(str, ar, ar_size, endptr, [](const char *s, const char **e) { return str_to_i64(s, e); });
+}
+
+size_t json_arr_u64(const char *str, uint64_t *ar, size_t ar_size, const char **endptr) {
+  return json_arr_parse(str, ar, ar_size, endptr, [](const char *s, const char **e) { return str_to_u64(s, e); });
+}
+
+size_t json_arr_float(const char *str, float *ar, size_t ar_size, const char **endptr) {
+  return json_arr_parse(str, ar, ar_size, endptr, [](const char *s, const char **e) { return (float)str_to_double(s, '.', e); });
+}
+
+size_t json_arr_double(const char *str, double *ar, size_t ar_size, const char **endptr) {
+  return json_arr_parse(str, ar, ar_size, endptr, [](const char *s, const char **e) { return str_to_double(s, '.', e); });
+}
+
+size_t json_arr_str(const char *str, const char **ar, size_t *ar_len, size_t ar_size, const char **endptr) {
+  size_t i = 0;
+  return json_arr_parse(str, ar, ar_size, endptr, [&](const char *s, const char **e) -> const char * {
+    *e = s;
+    if (*s != '"') return NULL;
+    const char *end = str_end(s);
+    if (!end) return NULL;
+    if (ar_len && i < ar_size) ar_len[i] = end - s - 2;
+    i++;
+    *e = end;
+    return s + 1;
+  });
+}
+
+size_t json_index(const char *str, json_tok *tape, size_t tape_size) {
+  if (!str || !tape || tape_size == 0) return 0;
+
+  const char *p = str_ignore(str);
+  size_t count = 0;
+  size_t open = JSON_NPOS;  // Innermost open bracket; chained through .match
+
+  do {
+    // Skip whitespace and the implied ':' between keys and values
+    while (*p == ' ' || *p == '\r' || *p == '\n' || *p == '\t' || *p == ':') p++;
+    if (!*p) return 0;                                   // Truncated document
+    if (count == tape_size || count == (json_off_t)-1) return 0;  // Tape full
+    if ((size_t)(p - str) > (json_off_t)-1) return 0;  // Offset does not fit
+
+    json_tok *t = &tape[count];
+    t->type = *p;
+    t->pos = (json_off_t)(p - str);
+
+    switch (*p) {
+      case '[':
+      case '{':
+        t->match = (json_off_t)open;  // Remember the enclosing bracket
+        open = count;
+        p++;
+        break;
+      case ']':
+      case '}': {
+        if (open == JSON_NPOS || tape[open].type != (*p == ']' ? '[' : '{')) return 0;
+        size_t parent = tape[open].match;
+        tape[open].match = (json_off_t)count;
+        t->match = (json_off_t)open;
+        // Restore the sentinel, which may have been truncated to json_off_t
+        open = (parent == (json_off_t)JSON_NPOS) ? JSON_NPOS : parent;
+        p++;
+        break;
+      }
+      case ',':
+        if (open == JSON_NPOS) return 0;
+        p++;
+        break;
+      case '"': {
+        const char *s = p + 1;
+        while (*s && *s != '"') {
+          if (*s == '\\' && s[1]) s++;  // Skip the escaped character
+          s++;
+        }
+        if (!*s) return 0;  // Unterminated string
+        t->len = (json_off_t)(s + 1 - p);
+        p = s + 1;
+        break;
+      }
+      default: {
+        const char *s = p;
+        while (*s && *s != ',' && *s != ']' && *s != '}' && *s != ':' && *s != ' ' && *s != '\r' && *s != '\n' && *s != '\t') s++;
+        t->type = 0;
+        t->len = (json_off_t)(s - p);
+        p = s;
+        break;
+      }
+    }
+    count++;
+  } while (open != JSON_NPOS);
+
+  return count;
+}
+
+size_t json_next(const json_tok *tape, size_t count, size_t i) {
+  if (!tape || i >= count) return JSON_NPOS;
+  if (tape[i].type == '[' || tape[i].type == '{') return (size_t)tape[i].match + 1;
+  return i + 1;
+}
+
+size_t json_key(const char *str, const json_tok *tape, size_t count, size_t obj, const char *key) {
+  if (!str || !tape || !key || obj >= count || tape[obj].type != '{') return JSON_NPOS;
+
+  size_t key_len = strlen(key);
+  size_t end = tape[obj].match;
+  size_t i = obj + 1;
+  while (i + 1 < end) {
+    // Key token, then its value
+    const json_tok *k = &tape[i];
+    if (k->type == '"' && k->len == key_len + 2 && !memcmp(str + k->pos + 1, key, key_len)) return i + 1;
+    i = json_next(tape, count, i + 1);
+    if (tape[i].type == ',') i++;
+  }
+  return JSON_NPOS;
+}
+
+size_t json_at(const json_tok *tape, size_t count, size_t arr, size_t n) {
+  if (!tape || arr >= count || tape[arr].type != '[') return JSON_NPOS;
+
+  size_t end = tape[arr].match;
+  size_t i = arr + 1;
+  while (i < end) {
+    if (n-- == 0) return i;
+    i = json_next(tape, count, i);
+    if (tape[i].type == ',') i++;
+  }
+  return JSON_NPOS;
+}
+
+const char *json_str(const char *str, const json_tok *tok, size_t *len) {
+  if (!str || !tok) return NULL;
+  if (tok->type == '"') {
+    if (len) *len = tok->len - 2;
+    return str + tok->pos + 1;
+  }
+  if (tok->type == 0) {
+    if (len) *len = tok->len;
+    return str + tok->pos;
+  }
+  return NULL;
+}
+
+// Vectorized JSON structural stage (host builds).
+// Each 64-byte block is classified into bitmasks (bit i = byte i): backslashes,
+// quotes and structural characters. Escaped characters are resolved with carry
+// arithmetic on the backslash mask, and the in-string mask is the prefix-XOR of
+// the unescaped quotes (carry-less multiply where the CPU has it). br_end, str_end
+// and coma_end with an explicit length run on these masks for large inputs.
+#ifndef __AVR__
+struct json_scan_state {
+  uint64_t prev_escaped;    // 1 if the first byte of the next block is escaped
+  uint64_t prev_in_string;  // All ones if the previous block ended inside a string
+};
+
+struct json_masks {
+  uint64_t quote;      // Unescaped quotes
+  uint64_t in_string;  // Opening quote and string content (closing quote excluded)
+  uint64_t open;       // '[' and '{' outside strings
+  uint64_t close;      // ']' and '}' outside strings
+  uint64_t comma;      // ',' outside strings
+  uint64_t colon;      // ':' outside strings
+};
+
+#if defined(__SSE2__)
+static inline uint64_t json_eq_mask(const __m128i *v, char c) {
+  __m128i n = _mm_set1_epi8(c);
+  uint64_t m0 = (uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v[0], n));
+  uint64_t m1 = (uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v[1], n));
+  uint64_t m2 = (uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v[2], n));
+  uint64_t m3 = (uint16_t)_mm_movemask_epi8(_mm_cmpeq_epi8(v[3], n));
+  return m0 | (m1 << 16) | (m2 << 32) | (m3 << 48);
+}
+#elif defined(__ARM_NEON)
+static inline uint64_t json_eq_mask(const uint8x16_t *v, char c) {
+  const uint8x16_t bit = {1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128};
+  uint8x16_t n = vdupq_n_u8((uint8_t)c);
+  uint8x16_t m0 = vandq_u8(vceqq_u8(v[0], n), bit);
+  uint8x16_t m1 = vandq_u8(vceqq_u8(v[1], n), bit);
+  uint8x16_t m2 = vandq_u8(vceqq_u8(v[2], n), bit);
+  uint8x16_t m3 = vandq_u8(vceqq_u8(v[3], n), bit);
+  uint8x16_t sum = vpaddq_u8(vpaddq_u8(m0, m1), vpaddq_u8(m2, m3));
+  sum = vpaddq_u8(sum, sum);
+  return vgetq_lane_u64(vreinterpretq_u64_u8(sum), 0);
+}
+#endif
+
+static inline void json_classify(const char *b, uint64_t *bs, uint64_t *q, uint64_t *op, uint64_t *cl, uint64_t *cm, uint64_t *co) {
+#if defined(__SSE2__)
+  __m128i v[4];
+  for (uint8_t i = 0; i < 4; i++) v[i] = _mm_loadu_si128((const __m128i *)(b + i * 16));
+#elif defined(__ARM_NEON)
+  uint8x16_t v[4];
+  for (uint8_t i = 0; i < 4; i++) v[i] = vld1q_u8((const uint8_t *)(b + i * 16));
+#endif
+#if defined(__SSE2__) || defined(__ARM_NEON)
+  *bs = json_eq_mask(v, '\\');
+  *q = json_eq_mask(v, '"');
+  *op = json_eq_mask(v, '[') | json_eq_mask(v, '{');
+  *cl = json_eq_mask(v, ']') | json_eq_mask(v, '}');
+  *cm = json_eq_mask(v, ',');
+  *co = json_eq_mask(v, ':');
+#else
+  uint64_t m_bs = 0, m_q = 0, m_op = 0, m_cl = 0, m_cm = 0, m_co = 0;
+  for (uint8_t i = 0; i < 64; i++) {
+    uint64_t bit = 1ULL << i;
+    switch (b[i]) {
+      case '\\': m_bs |= bit; break;
+      case '"': m_q |= bit; break;
+      case '[':
+      case '{': m_op |= bit; break;
+      case ']':
+      case '}': m_cl |= bit; break;
+      case ',': m_cm |= bit; break;
+      case ':': m_co |= bit; break;
+    }
+  }
+  *bs = m_bs;
+  *q = m_q;
+  *op = m_op;
+  *cl = m_cl;
+  *cm = m_cm;
+  *co = m_co;
+#endif
+}
+
+// Mask of characters escaped by an odd-length run of backslashes
+static inline uint64_t json_find_escaped(uint64_t bs, uint64_t *prev_escaped) {
+  const uint64_t even_bits = 0x5555555555555555ULL;
+  bs &= ~*prev_escaped;  // An escaped backslash does not start a run
+  uint64_t follows_escape = (bs << 1) | *prev_escaped;
+  uint64_t odd_starts = bs & ~even_bits & ~follows_escape;
+  uint64_t even_starts_carry = odd_starts + bs;
+  *prev_escaped = even_starts_carry < bs ? 1 : 0;  // Run reaches the next block
+  uint64_t invert_mask = even_starts_carry << 1;
+  return (even_bits ^ invert_mask) & follows_escape;
+}
+
+// Bit i of the result is the XOR of bits 0..i of x
+static inline uint64_t json_prefix_xor(uint64_t x) {
+#if defined(__PCLMUL__)
+  return (uint64_t)_mm_cvtsi128_si64(_mm_clmulepi64_si128(_mm_set_epi64x(0, (int64_t)x), _mm_set1_epi8((char)0xFF), 0));
+#elif defined(__ARM_FEATURE_AES)
+  return (uint64_t)vmull_p64((poly64_t)x, (poly64_t)~0ULL);
+#else
+  x ^= x << 1;
+  x ^= x << 2;
+  x ^= x << 4;
+  x ^= x << 8;
+  x ^= x << 16;
+  x ^= x << 32;
+  return x;
+#endif
+}
+
+// Classifies the 64 bytes at b (fewer at the end of input, padded with spaces)
+static void json_scan_block(const char *b, size_t n, json_scan_state *st, json_masks *m) {
+  char tail[64];
+  if (n < 64) {
+    memset(tail, ' ', sizeof(tail));
+    memcpy(tail, b, n);
+    b = tail;
+  }
+
+  uint64_t bs, q, op, cl, cm, co;
+  json_classify(b, &bs, &q, &op, &cl, &cm, &co);
+
+  uint64_t escaped = json_find_escaped(bs, &st->prev_escaped);
+  m->quote = q & ~escaped;
+  m->in_string = json_prefix_xor(m->quote) ^ st->prev_in_string;
+  st->prev_in_string = (uint64_t)((int64_t)m->in_string >> 63);
+
+  uint64_t outside = ~(m->in_string | escaped);
+  m->open = op & outside;
+  m->close = cl & outside;
+  m->comma = cm & outside;
+  m->colon = co & outside;
+}
+
+static inline uint8_t json_ctz(uint64_t x) {
+  return (uint8_t)__builtin_ctzll(x);
+}
+#endif
+
+size_t json_structurals(const char *str, size_t len, json_off_t *pos, size_t pos_size) {
+  if (!str || !pos || pos_size == 0) return 0;
+
+  size_t count = 0;
+#ifndef __AVR__
+  json_scan_state st = {0, 0};
+  json_masks m;
+  for (size_t i = 0; i < len; i += 64) {
+    json_scan_block(str + i, len - i < 64 ? len - i : 64, &st, &m);
+    uint64_t s = m.quote | m.open | m.close | m.comma | m.colon;
+    while (s) {
+      if (count == pos_size || i + json_ctz(s) > (json_off_t)-1) return count;
+      pos[count++] = (json_off_t)(i + json_ctz(s));
+      s &= s - 1;
+    }
+  }
+#else
+  bool instr = false;
+  for (size_t i = 0; i < len; i++) {
+    char c = str[i];
+    if (c == '\\') {
+      i++;
+      continue;
+    }
+    if (instr) {
+      if (c != '"') continue;
+      instr = false;
+    } else if (c == '"') {
+      instr = true;
+    } else if (c != '[' && c != '{' && c != ']' && c != '}' && c != ',' && c != ':') {
+      continue;
+    }
+    if (count == pos_size || i > (json_off_t)-1) return count;
+    pos[count++] = (json_off_t)i;
+  }
+#endif
+  return count;
+}
+
+const char *str_end(const char *str, size_t len) {
+  if (!str) return NULL;
+#ifndef __AVR__
+  if (len >= JSON_SIMD_MIN) {
+    // The second unescaped quote closes the first string
+    json_scan_state st = {0, 0};
+    json_masks m;
+    bool instr = false;
+    for (size_t i = 0; i < len; i += 64) {
+      json_scan_block(str + i, len - i < 64 ? len - i : 64, &st, &m);
+      uint64_t q = m.quote;
+      if (!instr && q) {
+        q &= q - 1;  // Opening quote
+        instr = true;
+      }
+      if (instr && q) return str + i + json_ctz(q) + 1;
+    }
+    return NULL;
+  }
+#endif
+  bool instr = false;
+  for (size_t i = 0; i < len; i++) {
+    if (str[i] == '\\') {
+      i++;
+    } else if (str[i] == '"') {
+      if (instr) return str + i + 1;
+      instr = true;
+    }
+  }
+  return NULL;
+}
+
+const char *br_end(const char *str, size_t len) {
+  if (!str) return NULL;
+  size_t level = 0;
+#ifndef __AVR__
+  if (len >= JSON_SIMD_MIN) {
+    json_scan_state st = {0, 0};
+    json_masks m;
+    for (size_t i = 0; i < len; i += 64) {
+      json_scan_block(str + i, len - i < 64 ? len - i : 64, &st, &m);
+      uint64_t br = m.open | m.close;
+      // The level cannot return to zero in this block: count instead of walking
+      if (level > (size_t)__builtin_popcountll(m.close)) {
+        level += __builtin_popcountll(m.open) - __builtin_popcountll(m.close);
+        continue;
+      }
+      while (br) {
+        uint64_t bit = br & (0 - br);
+        if (m.open & bit) {
+          level++;
+        } else {
+          if (level == 0) return NULL;  // Unbalanced
+          if (--level == 0) return str + i + json_ctz(bit);
+        }
+        br &= br - 1;
+      }
+    }
+    return NULL;
+  }
+#endif
+  bool instr = false;
+  for (size_t i = 0; i < len; i++) {
+    char c = str[i];
+    if (c == '\\') {
+      i++;
+    } else if (instr) {
+      if (c == '"') instr = false;
+    } else if (c == '"') {
+      instr = true;
+    } else if (c == '[' || c == '{') {
+      level++;
+    } else if (c == ']' || c == '}') {
+      if (level == 0) return NULL;  // Unbalanced
+      if (--level == 0) return str + i;
+    }
+  }
+  return NULL;
+}
+
+const char *coma_end(const char *str, size_t len) {
+  if (!str) return NULL;
+#ifndef __AVR__
+  if (len >= JSON_SIMD_MIN) {
+    json_scan_state st = {0, 0};
+    json_masks m;
+    for (size_t i = 0; i < len; i += 64) {
+      json_scan_block(str + i, len - i < 64 ? len - i : 64, &st, &m);
+      uint64_t d = m.comma | m.close;
+      if (d) return str + i + json_ctz(d);
+    }
+    return NULL;
+  }
+#endif
+  bool instr = false;
+  for (size_t i = 0; i < len; i++) {
+    char c = str[i];
+    if (c == '\\') {
+      i++;
+    } else if (instr) {
+      if (c == '"') instr = false;
+    } else if (c == '"') {
+      instr = true;
+    } else if (c == ',' || c == '}' || c == ']') {
+      return str + i;
+    }
+  }
+  return NULL;
+}
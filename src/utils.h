@@ -73,16 +73,220 @@
 #define MAX_DECIMAL 15
 #endif
 
+/**
+ * @brief Returns a mask of the low `count` bits of type T.
+ * @tparam T The integer type of the mask.
+ * @param count The number of bits; 0 gives 0 and the width of T (or more) gives all bits.
+ * @return The mask.
+ */
+template <typename T>
+static constexpr T bitMask(uint8_t count);
+
 /**
  * @brief Extracts a specified bit field from a value of type T.
  * @tparam T The type of the input value (e.g., uint8_t, uint16_t, etc.).
  * @param v The input value from which to extract bits.
+ * @param start The starting position of the bit field (0-based index), below the width of T.
+ * @param count The number of bits to extract, up to the width of T.
+ * @return The extracted bit field as a value of type T.
+ */
+template <typename T>
+static constexpr T getBits(T v, uint8_t start, uint8_t count);
+
+/**
+ * @brief Sets every bit of a bit field to 1.
+ * @param v The input value.
+ * @param start The starting position of the bit field (0-based index).
+ * @param count The number of bits in the field.
+ * @return `v` with the field set.
+ */
+template <typename T>
+static constexpr T setBits(T v, uint8_t start, uint8_t count);
+
+/**
+ * @brief Clears every bit of a bit field.
+ * @param v The input value.
+ * @param start The starting position of the bit field (0-based index).
+ * @param count The number of bits in the field.
+ * @return `v` with the field cleared.
+ */
+template <typename T>
+static constexpr T clearBits(T v, uint8_t start, uint8_t count);
+
+/**
+ * @brief Replaces a bit field with a new value.
+ * @param v The input value.
  * @param start The starting position of the bit field (0-based index).
- * @param count The number of bits to extract.
+ * @param count The number of bits in the field.
+ * @param field The new field value; bits above `count` are ignored.
+ * @return `v` with the field replaced.
+ */
+template <typename T>
+static constexpr T insertBits(T v, uint8_t start, uint8_t count, T field);
+
+/**
+ * @brief Extracts a bit field whose position is known at compile time.
+ *
+ * The mask is a constant, so the extraction compiles to a shift and an AND (or a
+ * byte move). A field outside of T is a compile error.
+ *
+ * @tparam Start The starting position of the bit field (0-based index).
+ * @tparam Count The number of bits to extract.
+ * @param v The input value.
  * @return The extracted bit field as a value of type T.
  */
+template <uint8_t Start, uint8_t Count, typename T>
+static constexpr T getBits(T v);
+
+/**
+ * @brief Sets every bit of a compile-time bit field to 1.
+ * @tparam Start The starting position of the bit field (0-based index).
+ * @tparam Count The number of bits in the field.
+ * @param v The input value.
+ * @return `v` with the field set.
+ */
+template <uint8_t Start, uint8_t Count, typename T>
+static constexpr T setBits(T v);
+
+/**
+ * @brief Clears every bit of a compile-time bit field.
+ * @tparam Start The starting position of the bit field (0-based index).
+ * @tparam Count The number of bits in the field.
+ * @param v The input value.
+ * @return `v` with the field cleared.
+ */
+template <uint8_t Start, uint8_t Count, typename T>
+static constexpr T clearBits(T v);
+
+/**
+ * @brief Replaces a compile-time bit field with a new value.
+ * @tparam Start The starting position of the bit field (0-based index).
+ * @tparam Count The number of bits in the field.
+ * @param v The input value.
+ * @param field The new field value; bits above `Count` are ignored.
+ * @return `v` with the field replaced.
+ */
+template <uint8_t Start, uint8_t Count, typename T>
+static constexpr T insertBits(T v, T field);
+
+/**
+ * @struct bit_field
+ * @brief Describes one field of a register so it can be named once and reused.
+ *
+ * Example: `typedef bit_field<uint8_t, 4, 2> ds3231_hour_tens;` then
+ * `ds3231_hour_tens::get(reg)` and `reg = ds3231_hour_tens::set(reg, 1)`.
+ *
+ * @tparam T The register type.
+ * @tparam Start The starting position of the field (0-based index).
+ * @tparam Count The number of bits in the field.
+ */
+template <typename T, uint8_t Start, uint8_t Count>
+struct bit_field {
+  static_assert(Count > 0 && Start + Count <= sizeof(T) * 8, "bit field outside of T");
+  typedef T type;  ///< The register type.
+
+  /// The field mask in register position.
+  static constexpr T mask() { return (T)(bitMask<T>(Count) << Start); }
+  /// Extracts the field from a register value.
+  static constexpr T get(T v) { return getBits<Start, Count>(v); }
+  /// Returns the register value with the field replaced.
+  static constexpr T set(T v, T field) { return insertBits<Start, Count>(v, field); }
+  /// Returns the register value with the field cleared.
+  static constexpr T clear(T v) { return clearBits<Start, Count>(v); }
+};
+
+/**
+ * @brief Counts the set bits of a value.
+ * @param v The input value.
+ * @return The number of bits set to 1.
+ */
+template <typename T>
+static constexpr uint8_t bitCount(T v);
+
+/**
+ * @brief Counts the leading zero bits of a value.
+ * @param v The input value.
+ * @return The number of zero bits above the highest set bit; the width of T if `v` is 0.
+ */
+template <typename T>
+static constexpr uint8_t bitClz(T v);
+
+/**
+ * @brief Counts the trailing zero bits of a value.
+ * @param v The input value.
+ * @return The index of the lowest set bit; the width of T if `v` is 0.
+ */
+template <typename T>
+static constexpr uint8_t bitCtz(T v);
+
+/**
+ * @brief Rotates a value left.
+ * @param v The input value.
+ * @param n The number of bit positions; taken modulo the width of T.
+ * @return The rotated value.
+ */
+template <typename T>
+static constexpr T bitRotl(T v, uint8_t n);
+
+/**
+ * @brief Rotates a value right.
+ * @param v The input value.
+ * @param n The number of bit positions; taken modulo the width of T.
+ * @return The rotated value.
+ */
+template <typename T>
+static constexpr T bitRotr(T v, uint8_t n);
+
+/**
+ * @brief Reverses the byte order of a value.
+ * @param v The input value.
+ * @return The byte-swapped value.
+ */
+template <typename T>
+static constexpr T byteSwap(T v);
+
+/**
+ * @brief Reverses the bit order of a value.
+ * @param v The input value.
+ * @return The value with bit 0 and the top bit exchanged, and so on.
+ */
 template <typename T>
-static T getBits(T v, uint8_t start, uint8_t count);
+static constexpr T bitReverse(T v);
+
+/**
+ * @def BIT_NPOS
+ * @brief Returned by bitFindFirst() and bitFindNext() when no bit is set.
+ */
+#define BIT_NPOS ((size_t)-1)
+
+/**
+ * @brief Counts the set bits of a byte array, a word at a time.
+ * @param ar The input bytes.
+ * @param len The number of bytes.
+ * @return The number of bits set to 1.
+ */
+extern size_t bitCount(const uint8_t *ar, size_t len);
+
+/**
+ * @brief Finds the first set bit of a bitmap.
+ *
+ * Bit `i` is bit `i % 8` of byte `i / 8`, the numbering of Arduino's bitRead().
+ * Zero words are skipped whole.
+ *
+ * @param ar The bitmap.
+ * @param len The size of the bitmap in bytes.
+ * @return The index of the first set bit, or BIT_NPOS if none is set.
+ */
+extern size_t bitFindFirst(const uint8_t *ar, size_t len);
+
+/**
+ * @brief Finds the next set bit of a bitmap at or after a given index.
+ * @param ar The bitmap.
+ * @param len The size of the bitmap in bytes.
+ * @param from The bit index to start at.
+ * @return The index of the set bit, or BIT_NPOS if none is set.
+ */
+extern size_t bitFindNext(const uint8_t *ar, size_t len, size_t from);
 
 /**
  * @union union16
@@ -125,678 +329,2920 @@ union union64 {
   double d;         ///< 64-bit double-precision floating-point value.
 };
 
-#ifdef ARDUINO
 /**
- * @brief Checks if the specified time (in minutes) has elapsed since the last timestamp.
- * @param t Pointer to the timestamp (in milliseconds).
- * @param delay_min The delay time in minutes.
- * @param reset If true, updates the timestamp to the current time.
- * @return True if the specified time has elapsed, false otherwise.
+ * @brief Loads a big-endian 16-bit value from a possibly unaligned byte buffer.
+ * @param p The buffer.
+ * @return The value in native byte order.
  */
-extern bool on_min(uint32_t *t, uint32_t delay_min, bool reset = false);
+static inline uint16_t load_be16(const uint8_t *p);
 
 /**
- * @brief Checks if the specified time (in seconds) has elapsed since the last timestamp.
- * @param t Pointer to the timestamp (in milliseconds).
- * @param delay_sec The delay time in seconds.
- * @param reset If true, updates the timestamp to the current time.
- * @return True if the specified time has elapsed, false otherwise.
+ * @brief Loads a big-endian 32-bit value from a possibly unaligned byte buffer.
+ * @param p The buffer.
+ * @return The value in native byte order.
  */
-extern bool on_sec(uint32_t *t, uint32_t delay_sec, bool reset = false);
+static inline uint32_t load_be32(const uint8_t *p);
 
 /**
- * @brief Checks if the specified time (in milliseconds) has elapsed since the last timestamp.
- * @param t Pointer to the timestamp (in milliseconds).
- * @param delay_ms The delay time in milliseconds.
- * @param reset If true, updates the timestamp to the current time.
- * @return True if the specified time has elapsed, false otherwise.
+ * @brief Loads a big-endian 64-bit value from a possibly unaligned byte buffer.
+ * @param p The buffer.
+ * @return The value in native byte order.
  */
-extern bool on_ms(uint32_t *t, uint32_t delay_ms, bool reset = false);
+static inline uint64_t load_be64(const uint8_t *p);
 
 /**
- * @brief Checks if the specified time (in microseconds) has elapsed since the last timestamp.
- * @param t Pointer to the timestamp (in microseconds).
- * @param delay_us The delay time in microseconds.
- * @param reset If true, updates the timestamp to the current time.
- * @return True if the specified time has elapsed, false otherwise.
+ * @brief Loads a little-endian 16-bit value from a possibly unaligned byte buffer.
+ * @param p The buffer.
+ * @return The value in native byte order.
  */
-extern bool on_us(uint32_t *t, uint32_t delay_us, bool reset = false);
+static inline uint16_t load_le16(const uint8_t *p);
 
 /**
- * @brief Delays execution for the specified number of microseconds from the start time.
- * @param start The start time (in microseconds, typically obtained from micros()).
- * @param wait_us The delay time in microseconds.
+ * @brief Loads a little-endian 32-bit value from a possibly unaligned byte buffer.
+ * @param p The buffer.
+ * @return The value in native byte order.
  */
-extern void delay_us(uint32_t start, uint32_t wait_us);
+static inline uint32_t load_le32(const uint8_t *p);
 
 /**
- * @brief Delays execution for the specified number of milliseconds from the start time.
- * @param start The start time (in milliseconds, typically obtained from millis()).
- * @param wait_ms The delay time in milliseconds.
+ * @brief Loads a little-endian 64-bit value from a possibly unaligned byte buffer.
+ * @param p The buffer.
+ * @return The value in native byte order.
  */
-extern void delay_ms(uint32_t start, uint32_t wait_ms);
-#endif
+static inline uint64_t load_le64(const uint8_t *p);
+
 /**
- * @brief Converts a Binary-Coded Decimal (BCD) number to a decimal number.
- * @param bcd The BCD input number.
- * @return The decimal equivalent.
+ * @brief Stores a 16-bit value big-endian to a possibly unaligned byte buffer.
+ * @param p The buffer.
+ * @param v The value in native byte order.
  */
-extern uint8_t bcd2dec(uint8_t bcd);
+static inline void store_be16(uint8_t *p, uint16_t v);
 
 /**
- * @brief Converts a decimal number to a Binary-Coded Decimal (BCD) number.
- * @param dec The decimal input number.
- * @return The BCD equivalent.
+ * @brief Stores a 32-bit value big-endian to a possibly unaligned byte buffer.
+ * @param p The buffer.
+ * @param v The value in native byte order.
  */
-extern uint8_t dec2bcd(uint8_t dec);
+static inline void store_be32(uint8_t *p, uint32_t v);
 
 /**
- * @brief Converts a boolean value to a string.
- * @param num The boolean value (true/false).
- * @param str The output string buffer.
- * @param str_len The size of the buffer.
- * @param t Optional string to represent true (default: "true").
- * @param f Optional string to represent false (default: "false").
- * @return Pointer to the output string, or NULL on error.
+ * @brief Stores a 64-bit value big-endian to a possibly unaligned byte buffer.
+ * @param p The buffer.
+ * @param v The value in native byte order.
  */
-extern char *bool_to_str(bool num, char *str, uint8_t str_len, const char *t = nullptr, const char *f = nullptr);
+static inline void store_be64(uint8_t *p, uint64_t v);
 
 /**
- * @brief Converts an 8-bit signed integer to a string.
- * @param num The int8_t number to convert.
- * @param str The output string buffer.
- * @param str_len The size of the buffer.
- * @param base The numerical base (default: 10).
- * @return Pointer to the output string, or NULL on error.
+ * @brief Stores a 16-bit value little-endian to a possibly unaligned byte buffer.
+ * @param p The buffer.
+ * @param v The value in native byte order.
  */
-extern char *i8_to_str(int8_t num, char *str, uint8_t str_len, uint8_t base = 10);
+static inline void store_le16(uint8_t *p, uint16_t v);
 
 /**
- * @brief Converts an 8-bit unsigned integer to a string.
- * @param num The uint8_t number to convert.
- * @param str The output string buffer.
- * @param str_len The size of the buffer.
- * @param base The numerical base (default: 10).
- * @return Pointer to the output string, or NULL on error.
+ * @brief Stores a 32-bit value little-endian to a possibly unaligned byte buffer.
+ * @param p The buffer.
+ * @param v The value in native byte order.
  */
-extern char *u8_to_str(uint8_t num, char *str, uint8_t str_len, uint8_t base = 10);
+static inline void store_le32(uint8_t *p, uint32_t v);
 
 /**
- * @brief Converts a 16-bit signed integer to a string.
- * @param num The int16_t number to convert.
- * @param str The output string buffer.
- * @param str_len The size of the buffer.
- * @param base The numerical base (default: 10).
- * @return Pointer to the output string, or NULL on error.
+ * @brief Stores a 64-bit value little-endian to a possibly unaligned byte buffer.
+ * @param p The buffer.
+ * @param v The value in native byte order.
  */
-extern char *i16_to_str(int16_t num, char *str, uint8_t str_len, uint8_t base = 10);
+static inline void store_le64(uint8_t *p, uint64_t v);
 
 /**
- * @brief Converts a 16-bit unsigned integer to a string.
- * @param num The uint16_t number to convert.
- * @param str The output string buffer.
- * @param str_len The size of the buffer.
- * @param base The numerical base (default: 10).
- * @return Pointer to the output string, or NULL on error.
+ * @brief Loads a big-endian 32-bit IEEE 754 float from a possibly unaligned byte buffer.
+ * @param p The buffer.
+ * @return The value.
  */
-extern char *u16_to_str(uint16_t num, char *str, uint8_t str_len, uint8_t base = 10);
+static inline float load_be_float(const uint8_t *p);
 
 /**
- * @brief Converts a 32-bit signed integer to a string.
- * @param num The int32_t number to convert.
- * @param str The output string buffer.
- * @param str_len The size of the buffer.
- * @param base The numerical base (default: 10).
- * @return Pointer to the output string, or NULL on error.
+ * @brief Stores a float as a big-endian 32-bit IEEE 754 value to a possibly unaligned byte buffer.
+ * @param p The buffer.
+ * @param v The value.
  */
-extern char *i32_to_str(int32_t num, char *str, uint8_t str_len, uint8_t base = 10);
+static inline void store_be_float(uint8_t *p, float v);
 
 /**
- * @brief Converts a 32-bit unsigned integer to a string.
- * @param num The uint32_t number to convert.
- * @param str The output string buffer.
- * @param str_len The size of the buffer.
- * @param base The numerical base (default: 10).
- * @return Pointer to the output string, or NULL on error.
+ * @brief Loads a big-endian 64-bit (32-bit on AVR) IEEE 754 double from a possibly unaligned byte buffer.
+ * @param p The buffer.
+ * @return The value.
  */
-extern char *u32_to_str(uint32_t num, char *str, uint8_t str_len, uint8_t base = 10);
+static inline double load_be_double(const uint8_t *p);
 
 /**
- * @brief Converts a 64-bit signed integer to a string.
- * @param num The int64_t number to convert.
- * @param str The output string buffer.
- * @param str_len The size of the buffer.
- * @param base The numerical base (default: 10).
- * @return Pointer to the output string, or NULL on error.
+ * @brief Stores a double as a big-endian 64-bit (32-bit on AVR) IEEE 754 value to a possibly unaligned byte buffer.
+ * @param p The buffer.
+ * @param v The value.
  */
-extern char *i64_to_str(int64_t num, char *str, uint8_t str_len, uint8_t base = 10);
+static inline void store_be_double(uint8_t *p, double v);
 
 /**
- * @brief Converts a 64-bit unsigned integer to a string.
- * @param num The uint64_t number to convert.
- * @param str The output string buffer.
- * @param str_len The size of the buffer.
- * @param base The numerical base (default: 10).
- * @return Pointer to the output string, or NULL on error.
+ * @brief Loads a little-endian 32-bit IEEE 754 float from a possibly unaligned byte buffer.
+ * @param p The buffer.
+ * @return The value.
  */
-extern char *u64_to_str(uint64_t num, char *str, uint8_t str_len, uint8_t base = 10);
+static inline float load_le_float(const uint8_t *p);
 
 /**
- * @brief Converts a float to a string with specified formatting.
- * @param num The float number to convert.
- * @param str The output string buffer.
- * @param str_len The size of the buffer.
- * @param min_width The minimum field width for formatting.
- * @param dec The number of decimal places.
- * @return Pointer to the output string, or NULL on error.
+ * @brief Stores a float as a little-endian 32-bit IEEE 754 value to a possibly unaligned byte buffer.
+ * @param p The buffer.
+ * @param v The value.
  */
-extern char *float_to_str(float num, char *str, uint8_t str_len, int8_t min_width, uint8_t dec);
+static inline void store_le_float(uint8_t *p, float v);
 
 /**
- * @brief Converts a double to a string with specified formatting.
- * @param num The double number to convert.
- * @param str The output string buffer.
- * @param str_len The size of the buffer.
- * @param min_width The minimum field width for formatting.
- * @param dec The number of decimal places.
- * @return Pointer to the output string, or NULL on error.
+ * @brief Loads a little-endian 64-bit (32-bit on AVR) IEEE 754 double from a possibly unaligned byte buffer.
+ * @param p The buffer.
+ * @return The value.
  */
-extern char *double_to_str(double num, char *str, uint8_t str_len, int8_t min_width, uint8_t dec);
+static inline double load_le_double(const uint8_t *p);
 
 /**
- * @brief Converts a string to a boolean value.
- * @param str The input string to parse.
- * @param endptr Optional pointer to store the address of the first unparsed character.
- * @param t Optional string representing true (default: "true").
- * @param f Optional string representing false (default: "false").
- * @return The parsed boolean value, or false on error.
+ * @brief Stores a double as a little-endian 64-bit (32-bit on AVR) IEEE 754 value to a possibly unaligned byte buffer.
+ * @param p The buffer.
+ * @param v The value.
  */
-extern bool str_to_bool(const char *str, const char **endptr = nullptr, const char *t = nullptr, const char *f = nullptr);
+static inline void store_le_double(uint8_t *p, double v);
 
 /**
- * @brief Converts a string to an 8-bit signed integer.
- * @param str The input string to parse.
- * @param endptr Optional pointer to store the address of the first unparsed character.
- * @param base The numerical base (default: 10).
- * @return The parsed int8_t value, or 0 on error.
+ * @brief Reverses the byte order of each 16-bit element of an array.
+ *
+ * Works on any 16-bit element type, including union16 and int16_t arrays. Large arrays
+ * are shuffled 16 bytes at a time with SSSE3 or NEON where available.
+ *
+ * @param dst The output array; may be the same as `src`, but must not partially overlap it.
+ * @param src The input array.
+ * @param count The number of elements.
+ * @return Pointer to `dst`, or NULL on error.
  */
-extern int8_t str_to_i8(const char *str, const char **endptr = nullptr, uint8_t base = 10);
+extern void *swap16_arr(void *dst, const void *src, size_t count);
 
 /**
- * @brief Converts a string to an 8-bit unsigned integer.
- * @param str The input string to parse.
- * @param endptr Optional pointer to store the address of the first unparsed character.
- * @param base The numerical base (default: 10).
- * @return The parsed uint8_t value, or 0 on error.
+ * @brief Reverses the byte order of each 32-bit element of an array.
+ *
+ * Works on any 32-bit element type, including union32 and float arrays. Large arrays
+ * are shuffled 16 bytes at a time with SSSE3 or NEON where available.
+ *
+ * @param dst The output array; may be the same as `src`, but must not partially overlap it.
+ * @param src The input array.
+ * @param count The number of elements.
+ * @return Pointer to `dst`, or NULL on error.
  */
-extern uint8_t str_to_u8(const char *str, const char **endptr = nullptr, uint8_t base = 10);
+extern void *swap32_arr(void *dst, const void *src, size_t count);
 
 /**
- * @brief Converts a string to a 16-bit signed integer.
- * @param str The input string to parse.
- * @param endptr Optional pointer to store the address of the first unparsed character.
- * @param base The numerical base (default: 10).
- * @return The parsed int16_t value, or 0 on error.
+ * @brief Reverses the byte order of each 64-bit element of an array.
+ *
+ * Works on any 64-bit element type, including union64 and double arrays. Large arrays
+ * are shuffled 16 bytes at a time with SSSE3 or NEON where available.
+ *
+ * @param dst The output array; may be the same as `src`, but must not partially overlap it.
+ * @param src The input array.
+ * @param count The number of elements.
+ * @return Pointer to `dst`, or NULL on error.
  */
-extern int16_t str_to_i16(const char *str, const char **endptr = nullptr, uint8_t base = 10);
+extern void *swap64_arr(void *dst, const void *src, size_t count);
 
 /**
- * @brief Converts a string to a 16-bit unsigned integer.
- * @param str The input string to parse.
- * @param endptr Optional pointer to store the address of the first unparsed character.
- * @param base The numerical base (default: 10).
- * @return The parsed uint16_t value, or 0 on error.
+ * @brief Loads an array of big-endian 16-bit values from a byte buffer into native order.
+ * @param dst The output array of any 16-bit element type (e.g. uint16_t, union16).
+ * @param src The wire-format bytes; may be the same buffer as `dst`.
+ * @param count The number of elements.
+ * @return Pointer to `dst`, or NULL on error.
  */
-extern uint16_t str_to_u16(const char *str, const char **endptr = nullptr, uint8_t base = 10);
+extern void *load_be16_arr(void *dst, const uint8_t *src, size_t count);
 
 /**
- * @brief Converts a string to a 32-bit signed integer.
- * @param str The input string to parse.
- * @param endptr Optional pointer to store the address of the first unparsed character.
- * @param base The numerical base (default: 10).
- * @return The parsed int32_t value, or 0 on error.
+ * @brief Stores an array of 16-bit values to a byte buffer as big-endian.
+ * @param dst The wire-format output bytes; may be the same buffer as `src`.
+ * @param src The input array of any 16-bit element type (e.g. uint16_t, union16).
+ * @param count The number of elements.
+ * @return Pointer to `dst`, or NULL on error.
  */
-extern int32_t str_to_i32(const char *str, const char **endptr = nullptr, uint8_t base = 10);
+extern uint8_t *store_be16_arr(uint8_t *dst, const void *src, size_t count);
 
 /**
- * @brief Converts a string to a 32-bit unsigned integer.
- * @param str The input string to parse.
- * @param endptr Optional pointer to store the address of the first unparsed character.
- * @param base The numerical base (default: 10).
- * @return The parsed uint32_t value, or 0 on error.
+ * @brief Loads an array of big-endian 32-bit values from a byte buffer into native order.
+ * @param dst The output array of any 32-bit element type (e.g. uint32_t, union32).
+ * @param src The wire-format bytes; may be the same buffer as `dst`.
+ * @param count The number of elements.
+ * @return Pointer to `dst`, or NULL on error.
  */
-extern uint32_t str_to_u32(const char *str, const char **endptr = nullptr, uint8_t base = 10);
+extern void *load_be32_arr(void *dst, const uint8_t *src, size_t count);
 
 /**
- * @brief Converts a string to a 64-bit signed integer.
- * @param str The input string to parse.
- * @param endptr Optional pointer to store the address of the first unparsed character.
- * @param base The numerical base (default: 10).
- * @return The parsed int64_t value, or 0 on error.
+ * @brief Stores an array of 32-bit values to a byte buffer as big-endian.
+ * @param dst The wire-format output bytes; may be the same buffer as `src`.
+ * @param src The input array of any 32-bit element type (e.g. uint32_t, union32).
+ * @param count The number of elements.
+ * @return Pointer to `dst`, or NULL on error.
+ */
+extern uint8_t *store_be32_arr(uint8_t *dst, const void *src, size_t count);
+
+/**
+ * @brief Loads an array of big-endian 64-bit values from a byte buffer into native order.
+ * @param dst The output array of any 64-bit element type (e.g. uint64_t, union64).
+ * @param src The wire-format bytes; may be the same buffer as `dst`.
+ * @param count The number of elements.
+ * @return Pointer to `dst`, or NULL on error.
+ */
+extern void *load_be64_arr(void *dst, const uint8_t *src, size_t count);
+
+/**
+ * @brief Stores an array of 64-bit values to a byte buffer as big-endian.
+ * @param dst The wire-format output bytes; may be the same buffer as `src`.
+ * @param src The input array of any 64-bit element type (e.g. uint64_t, union64).
+ * @param count The number of elements.
+ * @return Pointer to `dst`, or NULL on error.
+ */
+extern uint8_t *store_be64_arr(uint8_t *dst, const void *src, size_t count);
+
+/**
+ * @brief Loads an array of little-endian 16-bit values from a byte buffer into native order.
+ * @param dst The output array of any 16-bit element type (e.g. uint16_t, union16).
+ * @param src The wire-format bytes; may be the same buffer as `dst`.
+ * @param count The number of elements.
+ * @return Pointer to `dst`, or NULL on error.
+ */
+extern void *load_le16_arr(void *dst, const uint8_t *src, size_t count);
+
+/**
+ * @brief Stores an array of 16-bit values to a byte buffer as little-endian.
+ * @param dst The wire-format output bytes; may be the same buffer as `src`.
+ * @param src The input array of any 16-bit element type (e.g. uint16_t, union16).
+ * @param count The number of elements.
+ * @return Pointer to `dst`, or NULL on error.
+ */
+extern uint8_t *store_le16_arr(uint8_t *dst, const void *src, size_t count);
+
+/**
+ * @brief Loads an array of little-endian 32-bit values from a byte buffer into native order.
+ * @param dst The output array of any 32-bit element type (e.g. uint32_t, union32).
+ * @param src The wire-format bytes; may be the same buffer as `dst`.
+ * @param count The number of elements.
+ * @return Pointer to `dst`, or NULL on error.
+ */
+extern void *load_le32_arr(void *dst, const uint8_t *src, size_t count);
+
+/**
+ * @brief Stores an array of 32-bit values to a byte buffer as little-endian.
+ * @param dst The wire-format output bytes; may be the same buffer as `src`.
+ * @param src The input array of any 32-bit element type (e.g. uint32_t, union32).
+ * @param count The number of elements.
+ * @return Pointer to `dst`, or NULL on error.
+ */
+extern uint8_t *store_le32_arr(uint8_t *dst, const void *src, size_t count);
+
+/**
+ * @brief Loads an array of little-endian 64-bit values from a byte buffer into native order.
+ * @param dst The output array of any 64-bit element type (e.g. uint64_t, union64).
+ * @param src The wire-format bytes; may be the same buffer as `dst`.
+ * @param count The number of elements.
+ * @return Pointer to `dst`, or NULL on error.
+ */
+extern void *load_le64_arr(void *dst, const uint8_t *src, size_t count);
+
+/**
+ * @brief Stores an array of 64-bit values to a byte buffer as little-endian.
+ * @param dst The wire-format output bytes; may be the same buffer as `src`.
+ * @param src The input array of any 64-bit element type (e.g. uint64_t, union64).
+ * @param count The number of elements.
+ * @return Pointer to `dst`, or NULL on error.
+ */
+extern uint8_t *store_le64_arr(uint8_t *dst, const void *src, size_t count);
+
+#ifdef ARDUINO
+/**
+ * @brief Checks if the specified time (in minutes) has elapsed since the last timestamp.
+ * @param t Pointer to the timestamp (in milliseconds).
+ * @param delay_min The delay time in minutes.
+ * @param reset If true, updates the timestamp to the current time.
+ * @return True if the specified time has elapsed, false otherwise.
+ */
+extern bool on_min(uint32_t *t, uint32_t delay_min, bool reset = false);
+
+/**
+ * @brief Checks if the specified time (in seconds) has elapsed since the last timestamp.
+ * @param t Pointer to the timestamp (in milliseconds).
+ * @param delay_sec The delay time in seconds.
+ * @param reset If true, updates the timestamp to the current time.
+ * @return True if the specified time has elapsed, false otherwise.
+ */
+extern bool on_sec(uint32_t *t, uint32_t delay_sec, bool reset = false);
+
+/**
+ * @brief Checks if the specified time (in milliseconds) has elapsed since the last timestamp.
+ * @param t Pointer to the timestamp (in milliseconds).
+ * @param delay_ms The delay time in milliseconds.
+ * @param reset If true, updates the timestamp to the current time.
+ * @return True if the specified time has elapsed, false otherwise.
+ */
+extern bool on_ms(uint32_t *t, uint32_t delay_ms, bool reset = false);
+
+/**
+ * @brief Checks if the specified time (in microseconds) has elapsed since the last timestamp.
+ * @param t Pointer to the timestamp (in microseconds).
+ * @param delay_us The delay time in microseconds.
+ * @param reset If true, updates the timestamp to the current time.
+ * @return True if the specified time has elapsed, false otherwise.
+ */
+extern bool on_us(uint32_t *t, uint32_t delay_us, bool reset = false);
+
+/**
+ * @brief Returns micros() extended to 64 bits, which does not wrap in practice.
+ *
+ * Safe to call from interrupts and the main loop alike. It must be called at least
+ * once every 35 minutes (half the micros() range) to notice every wraparound.
+ * @return Microseconds since startup.
+ */
+extern uint64_t micros64();
+
+/**
+ * @brief Returns millis() extended to 64 bits, which does not wrap in practice.
+ *
+ * Safe to call from interrupts and the main loop alike. It must be called at least
+ * once every 24 days (half the millis() range) to notice every wraparound.
+ * @return Milliseconds since startup.
+ */
+extern uint64_t millis64();
+
+/**
+ * @brief 64-bit on_min(): checks if the specified time (in minutes) has elapsed.
+ * @param t Pointer to the timestamp (in milliseconds, from millis64()).
+ * @param delay_min The delay time in minutes.
+ * @param reset If true, updates the timestamp to the current time.
+ * @return True if the specified time has elapsed, false otherwise.
+ */
+extern bool on_min64(uint64_t *t, uint64_t delay_min, bool reset = false);
+
+/**
+ * @brief 64-bit on_sec(): checks if the specified time (in seconds) has elapsed.
+ * @param t Pointer to the timestamp (in milliseconds, from millis64()).
+ * @param delay_sec The delay time in seconds.
+ * @param reset If true, updates the timestamp to the current time.
+ * @return True if the specified time has elapsed, false otherwise.
+ */
+extern bool on_sec64(uint64_t *t, uint64_t delay_sec, bool reset = false);
+
+/**
+ * @brief 64-bit on_ms(): checks if the specified time (in milliseconds) has elapsed.
+ * @param t Pointer to the timestamp (in milliseconds, from millis64()).
+ * @param delay_ms The delay time in milliseconds.
+ * @param reset If true, updates the timestamp to the current time.
+ * @return True if the specified time has elapsed, false otherwise.
+ */
+extern bool on_ms64(uint64_t *t, uint64_t delay_ms, bool reset = false);
+
+/**
+ * @brief 64-bit on_us(): checks if the specified time (in microseconds) has elapsed.
+ *
+ * Unlike on_us(), intervals may exceed the 71-minute micros() range.
+ * @param t Pointer to the timestamp (in microseconds, from micros64()).
+ * @param delay_us The delay time in microseconds.
+ * @param reset If true, updates the timestamp to the current time.
+ * @return True if the specified time has elapsed, false otherwise.
+ */
+extern bool on_us64(uint64_t *t, uint64_t delay_us, bool reset = false);
+
+/**
+ * @brief Drift-free periodic check in minutes: the timestamp advances by whole periods.
+ * @param t Pointer to the start of the current period, i.e. the last tick (in milliseconds).
+ * @param period_min The period in minutes.
+ * @param catch_up If true, advances one period per call so missed periods fire on the next
+ *                 calls; if false, skips them and keeps the phase.
+ * @return The number of periods elapsed: 0 if not due yet, 1 on time, more if periods were missed.
+ *         Always 1 per due call in catch-up mode.
+ */
+extern uint32_t every_min(uint32_t *t, uint32_t period_min, bool catch_up = false);
+
+/**
+ * @brief Drift-free periodic check in seconds: the timestamp advances by whole periods.
+ * @param t Pointer to the start of the current period, i.e. the last tick (in milliseconds).
+ * @param period_sec The period in seconds.
+ * @param catch_up If true, advances one period per call so missed periods fire on the next
+ *                 calls; if false, skips them and keeps the phase.
+ * @return The number of periods elapsed: 0 if not due yet, 1 on time, more if periods were missed.
+ *         Always 1 per due call in catch-up mode.
+ */
+extern uint32_t every_sec(uint32_t *t, uint32_t period_sec, bool catch_up = false);
+
+/**
+ * @brief Drift-free periodic check in milliseconds: the timestamp advances by whole periods.
+ *
+ * Unlike on_ms() with reset, the loop latency does not accumulate, so a periodic task
+ * stays phase-locked to its start time.
+ * @param t Pointer to the start of the current period, i.e. the last tick (in milliseconds).
+ * @param period_ms The period in milliseconds.
+ * @param catch_up If true, advances one period per call so missed periods fire on the next
+ *                 calls; if false, skips them and keeps the phase.
+ * @return The number of periods elapsed: 0 if not due yet, 1 on time, more if periods were missed.
+ *         Always 1 per due call in catch-up mode.
+ */
+extern uint32_t every_ms(uint32_t *t, uint32_t period_ms, bool catch_up = false);
+
+/**
+ * @brief Drift-free periodic check in microseconds: the timestamp advances by whole periods.
+ * @param t Pointer to the start of the current period, i.e. the last tick (in microseconds).
+ * @param period_us The period in microseconds.
+ * @param catch_up If true, advances one period per call so missed periods fire on the next
+ *                 calls; if false, skips them and keeps the phase.
+ * @return The number of periods elapsed: 0 if not due yet, 1 on time, more if periods were missed.
+ *         Always 1 per due call in catch-up mode.
+ */
+extern uint32_t every_us(uint32_t *t, uint32_t period_us, bool catch_up = false);
+
+/**
+ * @brief Delays execution for the specified number of microseconds from the start time.
+ * @param start The start time (in microseconds, typically obtained from micros()).
+ * @param wait_us The delay time in microseconds.
+ */
+extern void delay_us(uint32_t start, uint32_t wait_us);
+
+/**
+ * @brief Delays execution for the specified number of milliseconds from the start time.
+ * @param start The start time (in milliseconds, typically obtained from millis()).
+ * @param wait_ms The delay time in milliseconds.
+ */
+extern void delay_ms(uint32_t start, uint32_t wait_ms);
+
+/**
+ * @enum task_state
+ * @brief What a scheduler task returns to the dispatcher.
+ */
+enum task_state : uint8_t {
+  TASK_READY = 0,  ///< Run again as soon as possible (yield or condition wait).
+  TASK_WAITING,    ///< Run again after `wait` microseconds.
+  TASK_DONE        ///< Finished; removed from the scheduler.
+};
+
+struct task;
+
+/**
+ * @typedef task_fn
+ * @brief A task body: written between TASK_BEGIN() and TASK_END(), returns a task_state.
+ */
+typedef uint8_t (*task_fn)(task *tk);
+
+/**
+ * @struct task
+ * @brief A stackless, protothread-style cooperative task.
+ *
+ * The body resumes where it last waited, but local variables do not survive a
+ * wait; keep state in static variables or in the object behind `arg`.
+ */
+struct task {
+  task_fn fn;         ///< The task body.
+  void *arg;          ///< User data for the body.
+  uint32_t deadline;  ///< micros() time the task is due.
+  uint32_t wait;      ///< Sleep requested by TASK_WAIT_US(), in microseconds.
+  uint16_t lc;        ///< Resume point (source line), 0 at the start.
+};
+
+/**
+ * @struct scheduler
+ * @brief Cooperative dispatcher running the earliest-due task from a min-heap of deadlines.
+ */
+struct scheduler {
+  task **heap;   ///< Heap storage, one slot per task.
+  uint8_t size;  ///< Number of scheduled tasks.
+  uint8_t cap;   ///< Size of the heap storage.
+  uint32_t now;  ///< micros() time of the current dispatch.
+};
+
+/**
+ * @def TASK_BEGIN
+ * @brief Starts a task body; must be paired with TASK_END() in the same function.
+ *
+ * The wait macros resume through `case __LINE__`, so put at most one per source line
+ * and do not use them inside another switch statement.
+ */
+#define TASK_BEGIN(tk) \
+  switch ((tk)->lc) {  \
+    case 0:
+
+/**
+ * @def TASK_END
+ * @brief Ends a task body; the task is removed from the scheduler when it gets here.
+ */
+#define TASK_END(tk) \
+  }                  \
+  (tk)->lc = 0;      \
+  return TASK_DONE
+
+/**
+ * @def TASK_YIELD
+ * @brief Lets the other due tasks run, then continues.
+ */
+#define TASK_YIELD(tk)      \
+  do {                      \
+    (tk)->lc = __LINE__;    \
+    return TASK_READY;      \
+    case __LINE__:;         \
+  } while (0)
+
+/**
+ * @def TASK_WAIT_US
+ * @brief Suspends the task for the given number of microseconds (at most 0x7FFFFFFF).
+ */
+#define TASK_WAIT_US(tk, us) \
+  do {                       \
+    (tk)->wait = (us);       \
+    (tk)->lc = __LINE__;     \
+    return TASK_WAITING;     \
+    case __LINE__:;          \
+  } while (0)
+
+/**
+ * @def TASK_WAIT_MS
+ * @brief Suspends the task for the given number of milliseconds (at most 2147483).
+ */
+#define TASK_WAIT_MS(tk, ms) TASK_WAIT_US(tk, (uint32_t)(ms) * 1000UL)
+
+/**
+ * @def TASK_FALLTHROUGH
+ * @brief Marks the deliberate fall-through into a resume label for -Wimplicit-fallthrough.
+ */
+#if defined(__GNUC__) && __GNUC__ >= 7
+#define TASK_FALLTHROUGH __attribute__((fallthrough))
+#else
+#define TASK_FALLTHROUGH
+#endif
+
+/**
+ * @def TASK_WAIT_UNTIL
+ * @brief Suspends the task until the condition is true; it is checked on every dispatch of the task.
+ */
+#define TASK_WAIT_UNTIL(tk, cond)     \
+  do {                                \
+    (tk)->lc = __LINE__;              \
+    TASK_FALLTHROUGH;                 \
+    case __LINE__:                    \
+      if (!(cond)) return TASK_READY; \
+  } while (0)
+
+/**
+ * @brief Initializes a scheduler over caller-provided heap storage.
+ * @param s The scheduler.
+ * @param heap An array with one slot per task.
+ * @param cap The number of slots.
+ * @return true on success, false on invalid parameters.
+ */
+extern bool sched_init(scheduler *s, task **heap, uint8_t cap);
+
+/**
+ * @brief Adds a task; it starts at TASK_BEGIN() once due.
+ * @param s The scheduler.
+ * @param tk The task storage; must stay valid while the task runs.
+ * @param fn The task body.
+ * @param arg User data, available as `tk->arg` (default: nullptr).
+ * @param delay_us Delay before the first run in microseconds (default: 0).
+ * @return true on success, false if the scheduler is full or a parameter is invalid.
+ */
+extern bool sched_add(scheduler *s, task *tk, task_fn fn, void *arg = nullptr, uint32_t delay_us = 0);
+
+/**
+ * @brief Runs the earliest-due task if its deadline has passed; call it from loop().
+ * @param s The scheduler.
+ * @return 0 if a task ran, otherwise the microseconds until the next task is due
+ *         (0xFFFFFFFF when no task is scheduled).
+ */
+extern uint32_t sched_run(scheduler *s);
+#endif
+
+/**
+ * @def TIMER_NONE
+ * @brief Empty link or bucket in a timer wheel.
+ */
+#define TIMER_NONE 0xFFFF
+
+/**
+ * @struct timer_node
+ * @brief One timer of a timer_wheel; allocate an array with one node per timer ID.
+ */
+struct timer_node {
+  uint32_t deadline;  ///< Expiry time in clock units.
+  uint16_t next;      ///< Next timer in the bucket, or TIMER_NONE.
+  uint16_t prev;      ///< Previous timer in the bucket, or TIMER_NONE for the first.
+  bool active;        ///< true while the timer runs.
+};
+
+/**
+ * @struct timer_wheel
+ * @brief Hashed timer wheel for many independent timeouts over static storage.
+ *
+ * Starting and cancelling a timer is O(1), and a poll only visits the buckets of
+ * the clock ticks that passed since the previous poll. The clock (millis(),
+ * micros() or any other wrapping 32-bit counter) is read once by the caller and
+ * passed to timer_wheel_poll().
+ */
+struct timer_wheel {
+  timer_node *nodes;  ///< Timer array, indexed by timer ID.
+  uint16_t *buckets;  ///< First timer of each bucket.
+  uint16_t count;     ///< Number of timers.
+  uint16_t mask;      ///< Number of buckets - 1.
+  uint8_t shift;      ///< log2 of the clock units per tick.
+  uint32_t now;       ///< Clock value of the last poll; delays count from it.
+  uint32_t tick;      ///< First tick the next poll visits.
+};
+
+/**
+ * @brief Initializes a timer wheel over caller-provided arrays; all timers start stopped.
+ * @param tw The wheel to initialize.
+ * @param nodes The timer array, one node per timer ID.
+ * @param count The number of timers (less than 65535).
+ * @param buckets The bucket array.
+ * @param bucket_count The number of buckets, a power of two.
+ * @param now The current clock value (e.g. millis()).
+ * @param shift log2 of the clock units per wheel tick (default: 0, one tick per unit).
+ * @return true on success, false on invalid parameters.
+ */
+extern bool timer_wheel_init(timer_wheel *tw, timer_node *nodes, uint16_t count, uint16_t *buckets,
+                             uint16_t bucket_count, uint32_t now, uint8_t shift = 0);
+
+/**
+ * @brief Starts or restarts a timer.
+ * @param tw The wheel.
+ * @param id The timer ID.
+ * @param delay The timeout in clock units, counted from the last poll (at most 0x7FFFFFFF).
+ * @return true on success, false on an invalid ID or delay.
+ */
+extern bool timer_start(timer_wheel *tw, uint16_t id, uint32_t delay);
+
+/**
+ * @brief Stops a timer.
+ * @param tw The wheel.
+ * @param id The timer ID.
+ * @return true if the timer was running, false otherwise.
+ */
+extern bool timer_cancel(timer_wheel *tw, uint16_t id);
+
+/**
+ * @brief Checks whether a timer is running.
+ * @param tw The wheel.
+ * @param id The timer ID.
+ * @return true if the timer is running, false otherwise.
+ */
+extern bool timer_active(const timer_wheel *tw, uint16_t id);
+
+/**
+ * @brief Advances the wheel to the current time and collects the expired timers.
+ * @param tw The wheel.
+ * @param now The current clock value, read once per loop.
+ * @param expired The output array of expired timer IDs; they are stopped.
+ * @param max The size of the output array. Timers beyond it expire on the next poll.
+ * @return The number of expired timers.
+ */
+extern size_t timer_wheel_poll(timer_wheel *tw, uint32_t now, uint16_t *expired, size_t max);
+
+/**
+ * @brief Converts a Binary-Coded Decimal (BCD) number to a decimal number.
+ * @param bcd The BCD input number.
+ * @return The decimal equivalent.
+ */
+extern uint8_t bcd2dec(uint8_t bcd);
+
+/**
+ * @brief Converts a decimal number to a Binary-Coded Decimal (BCD) number.
+ * @param dec The decimal input number (0-99).
+ * @return The BCD equivalent.
+ */
+extern uint8_t dec2bcd(uint8_t dec);
+
+/**
+ * @brief Converts an array of packed BCD bytes to decimal, e.g. an RTC register block.
+ *
+ * Several bytes are converted at once in a word (4 on AVR, 8 on 64-bit hosts).
+ *
+ * @param bcd The BCD input bytes.
+ * @param dec The output array; may be the same as `bcd`.
+ * @param len The number of bytes.
+ * @return Pointer to `dec`, or NULL on error.
+ */
+extern uint8_t *bcd2dec(const uint8_t *bcd, uint8_t *dec, size_t len);
+
+/**
+ * @brief Converts an array of decimal bytes (0-99) to packed BCD, without division.
+ *
+ * Several bytes are converted at once in a word (4 on AVR, 8 on 64-bit hosts).
+ * Bytes above 99 give the same result as dec2bcd(uint8_t) and never change their
+ * neighbours.
+ *
+ * @param dec The decimal input bytes.
+ * @param bcd The output array; may be the same as `dec`.
+ * @param len The number of bytes.
+ * @return Pointer to `bcd`, or NULL on error.
+ */
+extern uint8_t *dec2bcd(const uint8_t *dec, uint8_t *bcd, size_t len);
+
+/**
+ * @brief Converts an 8-digit packed BCD value to binary.
+ * @param bcd The packed BCD value, most significant digit in the top nibble.
+ * @return The binary value (0-99999999). Nibbles above 9 give an undefined result.
+ */
+extern uint32_t bcd32_to_u32(uint32_t bcd);
+
+/**
+ * @brief Converts a 16-digit packed BCD value to binary.
+ * @param bcd The packed BCD value, most significant digit in the top nibble.
+ * @return The binary value (0-9999999999999999). Nibbles above 9 give an undefined result.
+ */
+extern uint64_t bcd64_to_u64(uint64_t bcd);
+
+/**
+ * @brief Converts a binary value to 8-digit packed BCD, without division on AVR.
+ * @param num The value to convert; digits above the eighth are dropped.
+ * @return The packed BCD value.
+ */
+extern uint32_t u32_to_bcd32(uint32_t num);
+
+/**
+ * @brief Converts a binary value to 16-digit packed BCD.
+ * @param num The value to convert; digits above the sixteenth are dropped.
+ * @return The packed BCD value.
+ */
+extern uint64_t u64_to_bcd64(uint64_t num);
+
+/**
+ * @brief Converts an 8-digit packed BCD value straight to a decimal string.
+ * @param bcd The packed BCD value; leading zero digits are not printed.
+ * @param str The output string buffer.
+ * @param str_len The size of the buffer.
+ * @return Pointer to the output string, or NULL if the buffer is too small or a nibble is above 9.
+ */
+extern char *bcd32_to_str(uint32_t bcd, char *str, uint8_t str_len);
+
+/**
+ * @brief Converts a 16-digit packed BCD value straight to a decimal string.
+ * @param bcd The packed BCD value; leading zero digits are not printed.
+ * @param str The output string buffer.
+ * @param str_len The size of the buffer.
+ * @return Pointer to the output string, or NULL if the buffer is too small or a nibble is above 9.
+ */
+extern char *bcd64_to_str(uint64_t bcd, char *str, uint8_t str_len);
+
+/**
+ * @typedef bit_cache_t
+ * @brief Bit cache word of the bit streams: 32 bits on AVR, 64 bits elsewhere.
+ */
+#ifdef __AVR__
+typedef uint32_t bit_cache_t;
+#else
+typedef uint64_t bit_cache_t;
+#endif
+
+/**
+ * @struct bit_reader
+ * @brief Reads bit fields of any width from a byte buffer, MSB-first or LSB-first.
+ *
+ * Initialize with bit_reader_init(). Fields may cross byte boundaries; the next
+ * bits are kept in a cache word that is refilled a word at a time on 32/64-bit
+ * targets. Reading past the end returns 0 bits and sets `error`.
+ */
+struct bit_reader {
+  const uint8_t *buf;  ///< Input buffer.
+  size_t len;          ///< Size of the input buffer in bytes.
+  size_t pos;          ///< Next byte to load into the cache.
+  bit_cache_t cache;   ///< Bits loaded but not read yet.
+  uint8_t bits;        ///< Number of valid bits in `cache`.
+  bool lsb;            ///< true for LSB-first bit order.
+  bool error;          ///< Set when reading past the end of the buffer.
+};
+
+/**
+ * @struct bit_writer
+ * @brief Writes bit fields of any width to a byte buffer, MSB-first or LSB-first.
+ *
+ * Initialize with bit_writer_init() and finish with bit_flush(). Writing past the
+ * end of the buffer sets `error`.
+ */
+struct bit_writer {
+  uint8_t *buf;       ///< Output buffer.
+  size_t size;        ///< Size of the output buffer in bytes.
+  size_t pos;         ///< Next byte to write from the cache.
+  bit_cache_t cache;  ///< Bits written but not stored yet.
+  uint8_t bits;       ///< Number of valid bits in `cache`.
+  bool lsb;           ///< true for LSB-first bit order.
+  bool error;         ///< Set when the buffer is full.
+};
+
+/**
+ * @brief Initializes a bit reader over a byte buffer.
+ * @param br The reader to initialize.
+ * @param buf The input buffer.
+ * @param len The size of the input buffer in bytes.
+ * @param lsb_first true to read the least significant bit of each byte first (CAN, most
+ *                  little-endian protocols); false to read the most significant bit first.
+ */
+extern void bit_reader_init(bit_reader *br, const uint8_t *buf, size_t len, bool lsb_first = false);
+
+/**
+ * @brief Reads a bit field.
+ * @param br The reader.
+ * @param n The field width in bits (1-32).
+ * @return The field value, or 0 on error. Bits past the end of the buffer read as 0.
+ */
+extern uint32_t bit_read(bit_reader *br, uint8_t n);
+
+/**
+ * @brief Returns the next bits without consuming them.
+ * @param br The reader.
+ * @param n The number of bits (1-24 on AVR, 1-32 elsewhere).
+ * @return The bits, or 0 on error.
+ */
+extern uint32_t bit_peek(bit_reader *br, uint8_t n);
+
+/**
+ * @brief Skips bits.
+ * @param br The reader.
+ * @param n The number of bits to skip.
+ */
+extern void bit_skip(bit_reader *br, size_t n);
+
+/**
+ * @brief Skips to the next byte boundary.
+ * @param br The reader.
+ */
+extern void bit_align(bit_reader *br);
+
+/**
+ * @brief Returns the number of bits read so far.
+ * @param br The reader.
+ * @return The bit position in the buffer.
+ */
+extern size_t bit_tell(const bit_reader *br);
+
+/**
+ * @brief Reads whole bytes; at a byte boundary they are copied straight from the buffer.
+ * @param br The reader.
+ * @param dst The output array.
+ * @param n The number of bytes to read.
+ * @return The number of bytes read.
+ */
+extern size_t bit_read_bytes(bit_reader *br, uint8_t *dst, size_t n);
+
+/**
+ * @brief Initializes a bit writer over a byte buffer.
+ * @param bw The writer to initialize.
+ * @param buf The output buffer.
+ * @param size The size of the output buffer in bytes.
+ * @param lsb_first true to fill each byte from its least significant bit; false to fill
+ *                  from the most significant bit.
+ */
+extern void bit_writer_init(bit_writer *bw, uint8_t *buf, size_t size, bool lsb_first = false);
+
+/**
+ * @brief Writes a bit field.
+ * @param bw The writer.
+ * @param v The field value; bits above `n` are ignored.
+ * @param n The field width in bits (0-32).
+ * @return true on success, false if the buffer is full.
+ */
+extern bool bit_write(bit_writer *bw, uint32_t v, uint8_t n);
+
+/**
+ * @brief Writes whole bytes; at a byte boundary they are copied straight to the buffer.
+ * @param bw The writer.
+ * @param src The bytes to write.
+ * @param n The number of bytes.
+ * @return true on success, false if the buffer is full.
+ */
+extern bool bit_write_bytes(bit_writer *bw, const uint8_t *src, size_t n);
+
+/**
+ * @brief Stores the pending bits, padding the last byte with zeros.
+ * @param bw The writer.
+ * @return The number of bytes written to the buffer, or 0 if it overflowed.
+ */
+extern size_t bit_flush(bit_writer *bw);
+
+/**
+ * @struct xor_encoder
+ * @brief Streaming Gorilla-style XOR compressor for float or double time series.
+ *
+ * Each value is XORed with the previous one. Repeats cost one bit, and the XOR
+ * bits are sent inside a leading/trailing-zero window that is reused while it
+ * fits. Initialize with xor_encoder_init() and finish with xor_finish(). RAM use
+ * is constant.
+ */
+struct xor_encoder {
+  bit_writer bw;  ///< Output bit stream.
+  union64 prev;   ///< Previous value bits (`u32[0]` for floats).
+  size_t count;   ///< Number of values written.
+  uint8_t lead;   ///< Leading zeros of the current window.
+  uint8_t len;    ///< Width of the current window; 0 before the first one.
+  bool wide;      ///< true for a double stream.
+};
+
+/**
+ * @struct xor_decoder
+ * @brief Streaming decoder for the output of xor_encoder.
+ */
+struct xor_decoder {
+  bit_reader br;  ///< Input bit stream.
+  union64 prev;   ///< Previous value bits (`u32[0]` for floats).
+  size_t count;   ///< Number of values read.
+  uint8_t lead;   ///< Leading zeros of the current window.
+  uint8_t len;    ///< Width of the current window; 0 before the first one.
+  bool wide;      ///< true for a double stream.
+  bool end;       ///< Set when the end marker has been read.
+  bool error;     ///< Set on a malformed stream.
+};
+
+/**
+ * @brief Initializes an XOR encoder over an output buffer.
+ * @param enc The encoder to initialize.
+ * @param buf The output buffer.
+ * @param size The size of the buffer in bytes.
+ * @param wide true for a stream of doubles, false for floats (default).
+ */
+extern void xor_encoder_init(xor_encoder *enc, uint8_t *buf, size_t size, bool wide = false);
+
+/**
+ * @brief Appends a float to a float stream.
+ * @param enc The encoder.
+ * @param v The value.
+ * @return true on success, false if the buffer is full or the stream holds doubles. A refused
+ *         value changes nothing, and the values written before it can still be finished.
+ */
+extern bool xor_write_float(xor_encoder *enc, float v);
+
+/**
+ * @brief Appends a double to a double stream.
+ *
+ * On AVR, where double is 32 bits, double streams are only readable on AVR.
+ * @param enc The encoder.
+ * @param v The value.
+ * @return true on success, false if the buffer is full or the stream holds floats. A refused
+ *         value changes nothing, and the values written before it can still be finished.
+ */
+extern bool xor_write_double(xor_encoder *enc, double v);
+
+/**
+ * @brief Writes the end marker and the pending bits.
+ * @param enc The encoder.
+ * @return The total number of bytes in the buffer, or 0 if it overflowed.
+ */
+extern size_t xor_finish(xor_encoder *enc);
+
+/**
+ * @brief Returns the compression ratio so far: raw size over encoded size.
+ * @param enc The encoder.
+ * @return The ratio (e.g. 4.0 when 16 floats took 16 bytes), or 0 if nothing was written.
+ */
+extern float xor_ratio(const xor_encoder *enc);
+
+/**
+ * @brief Initializes an XOR decoder over an encoded buffer.
+ * @param dec The decoder to initialize.
+ * @param buf The encoded buffer.
+ * @param len The number of bytes in the buffer.
+ * @param wide true for a stream of doubles, false for floats (default).
+ */
+extern void xor_decoder_init(xor_decoder *dec, const uint8_t *buf, size_t len, bool wide = false);
+
+/**
+ * @brief Reads the next float of a float stream.
+ * @param dec The decoder.
+ * @param v Receives the value.
+ * @return true if a value was read, false at the end of the stream or on error.
+ */
+extern bool xor_read_float(xor_decoder *dec, float *v);
+
+/**
+ * @brief Reads the next double of a double stream.
+ * @param dec The decoder.
+ * @param v Receives the value.
+ * @return true if a value was read, false at the end of the stream or on error.
+ */
+extern bool xor_read_double(xor_decoder *dec, double *v);
+
+/**
+ * @brief Converts a boolean value to a string.
+ * @param num The boolean value (true/false).
+ * @param str The output string buffer.
+ * @param str_len The size of the buffer.
+ * @param t Optional string to represent true (default: "true").
+ * @param f Optional string to represent false (default: "false").
+ * @return Pointer to the output string, or NULL on error.
+ */
+extern char *bool_to_str(bool num, char *str, uint8_t str_len, const char *t = nullptr, const char *f = nullptr);
+
+/**
+ * @brief Converts an 8-bit signed integer to a string.
+ * @param num The int8_t number to convert.
+ * @param str The output string buffer.
+ * @param str_len The size of the buffer.
+ * @param base The numerical base (default: 10).
+ * @return Pointer to the output string, or NULL on error.
+ */
+extern char *i8_to_str(int8_t num, char *str, uint8_t str_len, uint8_t base = 10);
+
+/**
+ * @brief Converts an 8-bit unsigned integer to a string.
+ * @param num The uint8_t number to convert.
+ * @param str The output string buffer.
+ * @param str_len The size of the buffer.
+ * @param base The numerical base (default: 10).
+ * @return Pointer to the output string, or NULL on error.
+ */
+extern char *u8_to_str(uint8_t num, char *str, uint8_t str_len, uint8_t base = 10);
+
+/**
+ * @brief Converts a 16-bit signed integer to a string.
+ * @param num The int16_t number to convert.
+ * @param str The output string buffer.
+ * @param str_len The size of the buffer.
+ * @param base The numerical base (default: 10).
+ * @return Pointer to the output string, or NULL on error.
+ */
+extern char *i16_to_str(int16_t num, char *str, uint8_t str_len, uint8_t base = 10);
+
+/**
+ * @brief Converts a 16-bit unsigned integer to a string.
+ * @param num The uint16_t number to convert.
+ * @param str The output string buffer.
+ * @param str_len The size of the buffer.
+ * @param base The numerical base (default: 10).
+ * @return Pointer to the output string, or NULL on error.
+ */
+extern char *u16_to_str(uint16_t num, char *str, uint8_t str_len, uint8_t base = 10);
+
+/**
+ * @brief Converts a 32-bit signed integer to a string.
+ * @param num The int32_t number to convert.
+ * @param str The output string buffer.
+ * @param str_len The size of the buffer.
+ * @param base The numerical base (default: 10).
+ * @return Pointer to the output string, or NULL on error.
+ */
+extern char *i32_to_str(int32_t num, char *str, uint8_t str_len, uint8_t base = 10);
+
+/**
+ * @brief Converts a 32-bit unsigned integer to a string.
+ * @param num The uint32_t number to convert.
+ * @param str The output string buffer.
+ * @param str_len The size of the buffer.
+ * @param base The numerical base (default: 10).
+ * @return Pointer to the output string, or NULL on error.
+ */
+extern char *u32_to_str(uint32_t num, char *str, uint8_t str_len, uint8_t base = 10);
+
+/**
+ * @brief Converts a 64-bit signed integer to a string.
+ * @param num The int64_t number to convert.
+ * @param str The output string buffer.
+ * @param str_len The size of the buffer.
+ * @param base The numerical base (default: 10).
+ * @return Pointer to the output string, or NULL on error.
+ */
+extern char *i64_to_str(int64_t num, char *str, uint8_t str_len, uint8_t base = 10);
+
+/**
+ * @brief Converts a 64-bit unsigned integer to a string.
+ * @param num The uint64_t number to convert.
+ * @param str The output string buffer.
+ * @param str_len The size of the buffer.
+ * @param base The numerical base (default: 10).
+ * @return Pointer to the output string, or NULL on error.
+ */
+extern char *u64_to_str(uint64_t num, char *str, uint8_t str_len, uint8_t base = 10);
+
+/**
+ * @brief Converts a float to a string with specified formatting.
+ * @param num The float number to convert.
+ * @param str The output string buffer.
+ * @param str_len The size of the buffer.
+ * @param min_width The minimum field width for formatting.
+ * @param dec The number of decimal places.
+ * @return Pointer to the output string, or NULL on error.
+ */
+extern char *float_to_str(float num, char *str, uint8_t str_len, int8_t min_width, uint8_t dec);
+
+/**
+ * @brief Converts a double to a string with specified formatting.
+ * @param num The double number to convert.
+ * @param str The output string buffer.
+ * @param str_len The size of the buffer.
+ * @param min_width The minimum field width for formatting.
+ * @param dec The number of decimal places.
+ * @return Pointer to the output string, or NULL on error.
+ */
+extern char *double_to_str(double num, char *str, uint8_t str_len, int8_t min_width, uint8_t dec);
+
+/**
+ * @brief Converts a string to a boolean value.
+ * @param str The input string to parse.
+ * @param endptr Optional pointer to store the address of the first unparsed character.
+ * @param t Optional string representing true (default: "true").
+ * @param f Optional string representing false (default: "false").
+ * @return The parsed boolean value, or false on error.
+ */
+extern bool str_to_bool(const char *str, const char **endptr = nullptr, const char *t = nullptr, const char *f = nullptr);
+
+/**
+ * @brief Converts a string to an 8-bit signed integer.
+ * @param str The input string to parse.
+ * @param endptr Optional pointer to store the address of the first unparsed character.
+ * @param base The numerical base (default: 10).
+ * @return The parsed int8_t value, or 0 on error.
+ */
+extern int8_t str_to_i8(const char *str, const char **endptr = nullptr, uint8_t base = 10);
+
+/**
+ * @brief Converts a string to an 8-bit unsigned integer.
+ * @param str The input string to parse.
+ * @param endptr Optional pointer to store the address of the first unparsed character.
+ * @param base The numerical base (default: 10).
+ * @return The parsed uint8_t value, or 0 on error.
+ */
+extern uint8_t str_to_u8(const char *str, const char **endptr = nullptr, uint8_t base = 10);
+
+/**
+ * @brief Converts a string to a 16-bit signed integer.
+ * @param str The input string to parse.
+ * @param endptr Optional pointer to store the address of the first unparsed character.
+ * @param base The numerical base (default: 10).
+ * @return The parsed int16_t value, or 0 on error.
+ */
+extern int16_t str_to_i16(const char *str, const char **endptr = nullptr, uint8_t base = 10);
+
+/**
+ * @brief Converts a string to a 16-bit unsigned integer.
+ * @param str The input string to parse.
+ * @param endptr Optional pointer to store the address of the first unparsed character.
+ * @param base The numerical base (default: 10).
+ * @return The parsed uint16_t value, or 0 on error.
+ */
+extern uint16_t str_to_u16(const char *str, const char **endptr = nullptr, uint8_t base = 10);
+
+/**
+ * @brief Converts a string to a 32-bit signed integer.
+ * @param str The input string to parse.
+ * @param endptr Optional pointer to store the address of the first unparsed character.
+ * @param base The numerical base (default: 10).
+ * @return The parsed int32_t value, or 0 on error.
+ */
+extern int32_t str_to_i32(const char *str, const char **endptr = nullptr, uint8_t base = 10);
+
+/**
+ * @brief Converts a string to a 32-bit unsigned integer.
+ * @param str The input string to parse.
+ * @param endptr Optional pointer to store the address of the first unparsed character.
+ * @param base The numerical base (default: 10).
+ * @return The parsed uint32_t value, or 0 on error.
+ */
+extern uint32_t str_to_u32(const char *str, const char **endptr = nullptr, uint8_t base = 10);
+
+/**
+ * @brief Converts a string to a 64-bit signed integer.
+ * @param str The input string to parse.
+ * @param endptr Optional pointer to store the address of the first unparsed character.
+ * @param base The numerical base (default: 10).
+ * @return The parsed int64_t value, or 0 on error.
  */
 extern int64_t str_to_i64(const char *str, const char **endptr = nullptr, uint8_t base = 10);
 
 /**
- * @brief Converts a string to a 64-bit unsigned integer.
- * @param str The input string to parse.
- * @param endptr Optional pointer to store the address of the first unparsed character.
- * @param base The numerical base (default: 10).
- * @return The parsed uint64_t value, or 0 on error.
+ * @brief Converts a string to a 64-bit unsigned integer.
+ * @param str The input string to parse.
+ * @param endptr Optional pointer to store the address of the first unparsed character.
+ * @param base The numerical base (default: 10).
+ * @return The parsed uint64_t value, or 0 on error.
+ */
+extern uint64_t str_to_u64(const char *str, const char **endptr = nullptr, uint8_t base = 10);
+
+/**
+ * @brief Converts a string to a double-precision floating-point number.
+ * @param str The input string to parse.
+ * @param d The decimal separator character (e.g., '.' or ',').
+ * @param endptr Optional pointer to store the address of the first unparsed character.
+ * @return The parsed double value, or 0.0 on error.
+ */
+extern double str_to_double(const char *str, char d = '.', const char **endptr = nullptr);
+
+/**
+ * @brief Reverses the characters in a string.
+ * @param str The input string to reverse.
+ * @return Pointer to the reversed string, or NULL on error.
+ */
+extern char *str_reverse(char *str);
+
+/**
+ * @brief Reverses the first str_len characters of a buffer.
+ * @param str The buffer to reverse in place; it does not need to be null-terminated.
+ * @param str_len The number of characters to reverse.
+ * @return Pointer to the reversed buffer, or NULL on error.
+ */
+extern char *str_reverse(char *str, size_t str_len);
+
+/**
+ * @brief Counts occurrences of a character in a string.
+ *
+ * The string is read in aligned blocks, and the block holding the terminator is
+ * read whole: up to 31 bytes past the terminator, never across a page boundary.
+ * Those bytes may lie outside the allocation, so on hosts this overload is built
+ * without AddressSanitizer checks. The str_len overload never reads past str_len.
+ * @param str The input string to search.
+ * @param c The character to count.
+ * @return The number of occurrences of the character.
+ */
+extern size_t chr_count(const char *str, char c);
+
+/**
+ * @brief Counts occurrences of a character in a string until str_len.
+ * @param str The input string to search.
+ * @param str_len The input until count the existing char.
+ * @param c The character to count.
+ * @return The number of occurrences of the character.
+ */
+extern size_t chr_count(const char *str, size_t str_len, char c);
+/**
+ * @brief Counts occurrences of a substring in a string.
+ * @param str The input string to search.
+ * @param find The substring to count.
+ * @return The number of occurrences of the substring.
+ */
+extern size_t str_count(const char *str, const char *find);
+
+/**
+ * @brief Counts occurrences of a substring in the first str_len bytes of a buffer.
+ * @param str The buffer to search; it does not need to be null-terminated.
+ * @param str_len The number of bytes to search.
+ * @param find The substring to count.
+ * @return The number of occurrences of the substring.
+ */
+extern size_t str_count(const char *str, size_t str_len, const char *find);
+
+/**
+ * @brief Finds the first occurrence of a substring in a string.
+ *
+ * Short needles are located with a first-byte/last-byte filter and long ones with
+ * Horspool's algorithm, so the search does not compare at every offset.
+ *
+ * @param str The input string to search.
+ * @param find The substring to look for.
+ * @return Pointer to the first occurrence in `str`, or NULL if not found or `find` is empty.
+ */
+extern const char *str_find(const char *str, const char *find);
+
+/**
+ * @brief Finds the first occurrence of a substring in the first str_len bytes of a buffer.
+ * @param str The buffer to search; it does not need to be null-terminated and may contain NUL bytes.
+ * @param str_len The number of bytes to search.
+ * @param find The substring to look for.
+ * @return Pointer to the first occurrence in `str`, or NULL if not found or `find` is empty.
+ */
+extern const char *str_find(const char *str, size_t str_len, const char *find);
+
+/**
+ * @brief Finds all non-overlapping occurrences of a substring in a string.
+ * @param str The input string to search.
+ * @param find The substring to look for.
+ * @param pos Optional output array receiving the offset of each occurrence (may be NULL).
+ * @param pos_size The size of `pos`; further occurrences are counted but not stored.
+ * @return The number of occurrences.
+ */
+extern size_t str_find_all(const char *str, const char *find, size_t *pos, size_t pos_size);
+
+/**
+ * @brief Finds all non-overlapping occurrences of a substring in the first str_len bytes of a buffer.
+ * @param str The buffer to search; it does not need to be null-terminated and may contain NUL bytes.
+ * @param str_len The number of bytes to search.
+ * @param find The substring to look for.
+ * @param pos Optional output array receiving the offset of each occurrence (may be NULL).
+ * @param pos_size The size of `pos`; further occurrences are counted but not stored.
+ * @return The number of occurrences.
+ */
+extern size_t str_find_all(const char *str, size_t str_len, const char *find, size_t *pos, size_t pos_size);
+
+/**
+ * @struct ac_node
+ * @brief One state of a multi-keyword (Aho-Corasick) automaton.
+ *
+ * Nodes are produced by ac_build(). Node 0 is the root; index 0 in `child`, `next`
+ * and `dict` means "none". Because the table holds no pointers it can be copied into
+ * a `const ... PROGMEM` array on AVR and used with ac_attach_P().
+ */
+struct ac_node {
+  char ch;        ///< Character on the edge leading to this node.
+  uint8_t depth;  ///< Distance from the root (keyword length for output nodes).
+  uint8_t out;    ///< 1 + index of the keyword ending here, 0 if none.
+  uint16_t child; ///< First child.
+  uint16_t next;  ///< Next sibling.
+  uint16_t fail;  ///< Failure link.
+  uint16_t dict;  ///< Nearest keyword-ending node on the failure chain.
+};
+
+/**
+ * @struct ac_matcher
+ * @brief A built or attached Aho-Corasick automaton, ready for ac_scan().
+ */
+struct ac_matcher {
+  const ac_node *nodes;  ///< Node table (RAM, or flash if `progmem` is set).
+  uint16_t count;        ///< Number of nodes.
+  uint8_t keywords;      ///< Number of keywords.
+  bool progmem;          ///< The node table lives in flash (AVR only).
+};
+
+/**
+ * @brief Builds an Aho-Corasick automaton for a list of keywords.
+ *
+ * The automaton needs at most one node per keyword character plus the root. It is
+ * built once and can then scan any number of buffers, finding all keywords in a single
+ * pass. Repeated keywords are only reported for their first index.
+ *
+ * @param m The matcher to initialize.
+ * @param nodes Storage for the automaton nodes.
+ * @param nodes_size The number of entries in `nodes`.
+ * @param kw The keywords (non-empty, null-terminated, at most 255 characters).
+ * @param kw_count The number of keywords (at most 255).
+ * @return True on success, false if the input is invalid or `nodes` is too small.
+ */
+extern bool ac_build(ac_matcher *m, ac_node *nodes, uint16_t nodes_size, const char *const *kw, uint8_t kw_count);
+
+/**
+ * @brief Attaches a node table built earlier by ac_build() (e.g., a constant copy).
+ * @param m The matcher to initialize.
+ * @param nodes The node table.
+ * @param count The number of nodes.
+ * @param kw_count The number of keywords the table was built from.
+ */
+extern void ac_attach(ac_matcher *m, const ac_node *nodes, uint16_t count, uint8_t kw_count);
+
+#ifdef __AVR__
+/**
+ * @brief Attaches a node table stored in flash with PROGMEM.
+ * @param m The matcher to initialize.
+ * @param nodes The node table in program memory.
+ * @param count The number of nodes.
+ * @param kw_count The number of keywords the table was built from.
+ */
+extern void ac_attach_P(ac_matcher *m, const ac_node *nodes, uint16_t count, uint8_t kw_count);
+#endif
+
+/**
+ * @brief Scans a buffer once for all keywords of a matcher.
+ *
+ * Overlapping occurrences are all reported, including keywords that are suffixes of
+ * other keywords.
+ *
+ * @param m The matcher.
+ * @param str The buffer to scan (need not be null-terminated).
+ * @param len The number of bytes in `str`.
+ * @param counts Optional array of `m->keywords` entries receiving the count per keyword.
+ * @param first Optional array of `m->keywords` entries receiving the offset of the first
+ *              occurrence of each keyword, or `(size_t)-1` if it does not occur.
+ * @return The total number of matches.
+ */
+extern size_t ac_scan(const ac_matcher *m, const char *str, size_t len, size_t *counts = nullptr, size_t *first = nullptr);
+
+/**
+ * @brief Splits a string into an array of substrings based on a delimiter.
+ * @param str The input string to split.
+ * @param ar The output array to store substring pointers.
+ * @param ar_size The size of the output array.
+ * @param delim The delimiter character (default: ',').
+ */
+extern const char **str_cut(char *str, const char **ar, size_t ar_size, char delim = ',');
+
+/**
+ * @brief Splits the first str_len bytes of a buffer into substrings based on a delimiter.
+ *
+ * Delimiters are replaced with null terminators. The last substring is not terminated,
+ * as the buffer may have no room after it; use `ar_len` to get its length.
+ *
+ * @param str The buffer to split; it does not need to be null-terminated.
+ * @param str_len The number of bytes to split.
+ * @param ar The output array to store substring pointers.
+ * @param ar_len Optional output array receiving the length of each substring (may be NULL).
+ * @param ar_size The size of `ar` and `ar_len`.
+ * @param delim The delimiter character (default: ',').
+ * @return The number of substrings stored.
+ */
+extern size_t str_cut(char *str, size_t str_len, const char **ar, size_t *ar_len, size_t ar_size, char delim = ',');
+
+/**
+ * @brief Joins an array of characters into a string with a delimiter.
+ * @param ar The input array of characters.
+ * @param ar_size The size of the input array.
+ * @param buf The output string buffer.
+ * @param buf_size The size of the buffer.
+ * @param delim The delimiter character.
+ * @return Pointer to the output string, or NULL on error.
+ */
+extern char *join_chr_arr(const char *ar, size_t ar_size, char *buf, size_t buf_size, char delim);
+
+/**
+ * @brief Joins an array of boolean values into a string with a delimiter.
+ * @param ar The input array of boolean values.
+ * @param ar_size The size of the input array.
+ * @param buf The output string buffer.
+ * @param buf_size The size of the buffer.
+ * @param delim The delimiter character (default: ',').
+ * @param t Optional string to represent true (default: "true").
+ * @param f Optional string to represent false (default: "false").
+ * @return Pointer to the output string, or NULL on error.
+ */
+extern char *join_bool(const bool *ar, size_t ar_size, char *buf, size_t buf_size, char delim = ',', const char *t = nullptr, const char *f = nullptr);
+
+/**
+ * @brief Joins an array of 8-bit signed integers into a string with a delimiter.
+ * @param ar The input array of int8_t values.
+ * @param ar_size The size of the input array.
+ * @param buf The output string buffer.
+ * @param buf_size The size of the buffer.
+ * @param delim The delimiter character (default: ',').
+ * @param base The numerical base (default: 10).
+ * @return Pointer to the output string, or NULL on error.
+ */
+extern char *join_i8(const int8_t *ar, size_t ar_size, char *buf, size_t buf_size, char delim = ',', uint8_t base = 10);
+
+/**
+ * @brief Joins an array of 8-bit unsigned integers into a string with a delimiter.
+ * @param ar The input array of uint8_t values.
+ * @param ar_size The size of the input array.
+ * @param buf The output string buffer.
+ * @param buf_size The size of the buffer.
+ * @param delim The delimiter character (default: ',').
+ * @param base The numerical base (default: 10).
+ * @return Pointer to the output string, or NULL on error.
+ */
+extern char *join_u8(const uint8_t *ar, size_t ar_size, char *buf, size_t buf_size, char delim = ',', uint8_t base = 10);
+
+/**
+ * @brief Joins an array of 16-bit signed integers into a string with a delimiter.
+ * @param ar The input array of int16_t values.
+ * @param ar_size The size of the input array.
+ * @param buf The output string buffer.
+ * @param buf_size The size of the buffer.
+ * @param delim The delimiter character (default: ',').
+ * @param base The numerical base (default: 10).
+ * @return Pointer to the output string, or NULL on error.
+ */
+extern char *join_i16(const int16_t *ar, size_t ar_size, char *buf, size_t buf_size, char delim = ',', uint8_t base = 10);
+
+/**
+ * @brief Joins an array of 16-bit unsigned integers into a string with a delimiter.
+ * @param ar The input array of uint16_t values.
+ * @param ar_size The size of the input array.
+ * @param buf The output string buffer.
+ * @param buf_size The size of the buffer.
+ * @param delim The delimiter character (default: ',').
+ * @param base The numerical base (default: 10).
+ * @return Pointer to the output string, or NULL on error.
+ */
+extern char *join_u16(const uint16_t *ar, size_t ar_size, char *buf, size_t buf_size, char delim = ',', uint8_t base = 10);
+
+/**
+ * @brief Joins an array of 32-bit signed integers into a string with a delimiter.
+ * @param ar The input array of int32_t values.
+ * @param ar_size The size of the input array.
+ * @param buf The output string buffer.
+ * @param buf_size The size of the buffer.
+ * @param delim The delimiter character (default: ',').
+ * @param base The numerical base (default: 10).
+ * @return Pointer to the output string, or NULL on error.
+ */
+extern char *join_i32(const int32_t *ar, size_t ar_size, char *buf, size_t buf_size, char delim = ',', uint8_t base = 10);
+
+/**
+ * @brief Joins an array of 32-bit unsigned integers into a string with a delimiter.
+ * @param ar The input array of uint32_t values.
+ * @param ar_size The size of the input array.
+ * @param buf The output string buffer.
+ * @param buf_size The size of the buffer.
+ * @param delim The delimiter character (default: ',').
+ * @param base The numerical base (default: 10).
+ * @return Pointer to the output string, or NULL on error.
+ */
+extern char *join_u32(const uint32_t *ar, size_t ar_size, char *buf, size_t buf_size, char delim = ',', uint8_t base = 10);
+
+/**
+ * @brief Joins an array of 64-bit signed integers into a string with a delimiter.
+ * @param ar The input array of int64_t values.
+ * @param ar_size The size of the input array.
+ * @param buf The output string buffer.
+ * @param buf_size The size of the buffer.
+ * @param delim The delimiter character (default: ',').
+ * @param base The numerical base (default: 10).
+ * @return Pointer to the output string, or NULL on error.
+ */
+extern char *join_i64(const int64_t *ar, size_t ar_size, char *buf, size_t buf_size, char delim = ',', uint8_t base = 10);
+
+/**
+ * @brief Joins an array of 64-bit unsigned integers into a string with a delimiter.
+ * @param ar The input array of uint64_t values.
+ * @param ar_size The size of the input array.
+ * @param buf The output string buffer.
+ * @param buf_size The size of the buffer.
+ * @param delim The delimiter character (default: ',').
+ * @param base The numerical base (default: 10).
+ * @return Pointer to the output string, or NULL on error.
+ */
+extern char *join_u64(const uint64_t *ar, size_t ar_size, char *buf, size_t buf_size, char delim = ',', uint8_t base = 10);
+
+/**
+ * @brief Joins an array of floats into a string with a delimiter.
+ * @param ar The input array of float values.
+ * @param ar_size The size of the input array.
+ * @param buf The output string buffer.
+ * @param buf_size The size of the buffer.
+ * @param dec The number of decimal places.
+ * @param delim The delimiter character (default: ',').
+ * @return Pointer to the output string, or NULL on error.
+ */
+extern char *join_float(const float *ar, size_t ar_size, char *buf, size_t buf_size, uint8_t dec, char delim = ',');
+
+/**
+ * @brief Joins an array of doubles into a string with a delimiter.
+ * @param ar The input array of double values.
+ * @param ar_size The size of the input array.
+ * @param buf The output string buffer.
+ * @param buf_size The size of the buffer.
+ * @param dec The number of decimal places.
+ * @param delim The delimiter character (default: ',').
+ * @return Pointer to the output string, or NULL on error.
+ */
+extern char *join_double(const double *ar, size_t ar_size, char *buf, size_t buf_size, uint8_t dec, char delim = ',');
+
+/**
+ * @brief Joins an array of strings into a single string with a delimiter.
+ * @param ar The input array of strings.
+ * @param ar_size The size of the input array.
+ * @param buf The output string buffer.
+ * @param buf_size The size of the buffer.
+ * @param delim The delimiter character (default: ',').
+ * @return Pointer to the output string, or NULL on error.
+ */
+extern char *join_str(const char **ar, size_t ar_size, char *buf, size_t buf_size, char delim = ',');
+
+/**
+ * @brief Joins an array of strings with known lengths into a single string with a delimiter.
+ * @param ar The input array of strings; they do not need to be null-terminated.
+ * @param ar_len The length of each string in `ar`.
+ * @param ar_size The size of the input arrays.
+ * @param buf The output string buffer.
+ * @param buf_size The size of the buffer.
+ * @param delim The delimiter character (default: ',').
+ * @return Pointer to the output string, or NULL on error.
+ */
+extern char *join_str(const char **ar, const size_t *ar_len, size_t ar_size, char *buf, size_t buf_size, char delim = ',');
+
+/**
+ * @brief Splits a string into an array of boolean values based on a delimiter.
+ * @param str The input string to split.
+ * @param ar The output array to store boolean values.
+ * @param ar_size The size of the output array.
+ * @param delim The delimiter character (default: ',').
+ * @param t Optional string to represent true (default: "true").
+ * @param f Optional string to represent false (default: "false").
+ * @return Pointer to the output array, or NULL on error.
+ */
+extern bool *split_bool(const char *str, bool *ar, size_t ar_size, char delim = ',', const char *t = nullptr, const char *f = nullptr);
+
+/**
+ * @brief Splits the first str_len bytes of a buffer into an array of boolean values based on a delimiter.
+ * @param str The input buffer; it does not need to be null-terminated and is not modified.
+ * @param str_len The number of bytes to split.
+ * @param ar The output array to store bool values.
+ * @param ar_size The size of the output array.
+ * @param delim The delimiter character (default: ',').
+ * @param t Optional string to represent true (default: "true").
+ * @param f Optional string to represent false (default: "false").
+ * @return Pointer to the output array, or NULL on error.
+ */
+extern bool *split_bool(const char *str, size_t str_len, bool *ar, size_t ar_size, char delim = ',', const char *t = nullptr, const char *f = nullptr);
+
+/**
+ * @brief Splits a string into an array of characters based on a delimiter.
+ * @param str The input string to split.
+ * @param ar The output array to store characters.
+ * @param ar_size The size of the output array.
+ * @param delim The delimiter character (default: ',').
+ * @return Pointer to the output array, or NULL on error.
+ */
+extern char *split_chr(const char *str, char *ar, size_t ar_size, char delim = ',');
+
+/**
+ * @brief Splits the first str_len bytes of a buffer into an array of characters based on a delimiter.
+ * @param str The input buffer; it does not need to be null-terminated.
+ * @param str_len The number of bytes to split.
+ * @param ar The output array to store characters.
+ * @param ar_size The size of the output array.
+ * @param delim The delimiter character (default: ',').
+ * @return Pointer to the output array, or NULL on error.
+ */
+extern char *split_chr(const char *str, size_t str_len, char *ar, size_t ar_size, char delim = ',');
+
+/**
+ * @brief Splits a string into tokens based on a delimiter, extracting only quoted substrings.
+ *
+ * This function processes an input string, extracts substrings enclosed in double quotes (`"`), and stores them in a destination buffer.
+ * The extracted tokens are referenced by an array of pointers (`ar`). Non-quoted parts of the string are ignored, and the function supports
+ * escaped quotes (`\"`) and backslashes (`\\`) within quoted strings. The destination buffer can be the same as the input string for in-place processing.
+ *
+ * @param str The input string to process (null-terminated).
+ * @param dest The destination buffer where extracted tokens are stored.
+ * @param dest_size The size of the destination buffer (including space for null terminators).
+ * @param ar Array of pointers to store the starting addresses of extracted tokens.
+ * @param ar_size The size of the `ar` array (maximum number of tokens to extract).
+ * @param delim The delimiter character to separate tokens (default: ',').
+ *
+ * @return Pointer to the destination buffer (`dest`) on success, or `NULL` if any input parameter is invalid
+ *         (`str`, `dest`, or `ar` is `NULL`, or `dest_size` or `ar_size` is 0).
+ *
+ * @note The function modifies the `dest` buffer and may overwrite the input string if `str` and `dest` are the same.
+ * @note The caller must ensure `dest_size` is sufficient to hold all extracted tokens plus null terminators.
+ * @note Tokens exceeding `ar_size` are ignored, and the function stops processing if the `dest` buffer is full.
+ * @warning Ensure `dest_size` is large enough to avoid buffer overflow, especially in memory-constrained environments like Arduino.
+ */
+extern char *split_quoted_str(const char *str, char *dest, size_t dest_size, const char **ar, size_t ar_size, char delim = ',');
+
+/**
+ * @brief Extracts quoted substrings from the first str_len bytes of a buffer.
+ *
+ * Same as split_quoted_str(), but `str` does not need to be null-terminated.
+ *
+ * @param str The input buffer.
+ * @param str_len The number of bytes to process.
+ * @param dest The destination buffer where extracted tokens are stored.
+ * @param dest_size The size of the destination buffer (including space for null terminators).
+ * @param ar Array of pointers to store the starting addresses of extracted tokens.
+ * @param ar_size The size of the `ar` array (maximum number of tokens to extract).
+ * @param delim The delimiter character to separate tokens (default: ',').
+ * @return Pointer to the destination buffer (`dest`) on success, or `NULL` on invalid input.
+ */
+extern char *split_quoted_str(const char *str, size_t str_len, char *dest, size_t dest_size, const char **ar, size_t ar_size, char delim = ',');
+
+/**
+ * @brief Extracts quoted substrings and unescapes them in place, inside the input buffer.
+ *
+ * Works like split_quoted_str() without a destination buffer: each token is unescaped
+ * over its own source bytes, which always fits because the output is never longer than
+ * the input. The standard JSON escapes (`\"`, `\\`, `\/`, `\b`, `\f`, `\n`, `\r`, `\t`
+ * and `\uXXXX`, including surrogate pairs) are decoded to UTF-8. A lone surrogate
+ * (`\uD800`-`\uDFFF` without its pair) is written as the 3-byte sequence of the code
+ * unit (CESU-8 style), and a `\u` without four hex digits is kept as-is. Runs without
+ * escapes are skipped a machine word at a time and are not moved until the first escape.
+ *
+ * @param str The input string to process (null-terminated); it is modified.
+ * @param ar Array receiving the start of each token (null-terminated inside `str`).
+ * @param ar_len Optional array receiving the length of each token (may be NULL).
+ * @param ar_size The size of `ar` and `ar_len` (maximum number of tokens).
+ * @param delim The delimiter character between tokens (default: ',').
+ * @return The number of tokens extracted. Scanning stops at the first unterminated
+ *         string or at any character other than a delimiter, whitespace or `[`/`]`
+ *         between tokens.
+ */
+extern size_t split_quoted_str_inplace(char *str, const char **ar, size_t *ar_len, size_t ar_size, char delim = ',');
+
+/**
+ * @brief Extracts quoted substrings from the first str_len bytes of a buffer and unescapes them in place.
+ *
+ * Same as split_quoted_str_inplace(), but `str` does not need to be null-terminated.
+ * Each token is terminated inside the buffer, over its closing quote at the latest.
+ *
+ * @param str The input buffer; it is modified.
+ * @param str_len The number of bytes to process.
+ * @param ar Array receiving the start of each token.
+ * @param ar_len Optional array receiving the length of each token (may be NULL).
+ * @param ar_size The size of `ar` and `ar_len` (maximum number of tokens).
+ * @param delim The delimiter character between tokens (default: ',').
+ * @return The number of tokens extracted.
+ */
+extern size_t split_quoted_str_inplace(char *str, size_t str_len, const char **ar, size_t *ar_len, size_t ar_size, char delim = ',');
+
+extern const char **split_str(const char *str, char *dest, size_t dest_size, const char **ar, size_t ar_size, char delim = ',');
+
+/**
+ * @brief Copies the first str_len bytes of a buffer into `dest` as null-terminated tokens split on a delimiter.
+ * @param str The input buffer; it does not need to be null-terminated.
+ * @param str_len The number of bytes to split.
+ * @param dest The destination buffer for the tokens.
+ * @param dest_size The size of the destination buffer; copying stops when it is full.
+ * @param ar The output array receiving the start of each token; unused entries are set to NULL.
+ * @param ar_size The size of the output array.
+ * @param delim The delimiter character (default: ',').
+ * @return Pointer to the output array, or NULL on error.
+ */
+extern const char **split_str(const char *str, size_t str_len, char *dest, size_t dest_size, const char **ar, size_t ar_size, char delim = ',');
+
+/**
+ * @brief Splits a string into an array of 8-bit signed integers based on a delimiter.
+ * @param str The input string to split.
+ * @param ar The output array to store int8_t values.
+ * @param ar_size The size of the output array.
+ * @param delim The delimiter character (default: ',').
+ * @return Pointer to the output array, or NULL on error.
+ */
+extern int8_t *split_i8(const char *str, int8_t *ar, size_t ar_size, char delim = ',');
+
+/**
+ * @brief Splits the first str_len bytes of a buffer into an array of 8-bit signed integers based on a delimiter.
+ * @param str The input buffer; it does not need to be null-terminated and is not modified.
+ * @param str_len The number of bytes to split.
+ * @param ar The output array to store int8_t values.
+ * @param ar_size The size of the output array.
+ * @param delim The delimiter character (default: ',').
+ * @return Pointer to the output array, or NULL on error.
+ */
+extern int8_t *split_i8(const char *str, size_t str_len, int8_t *ar, size_t ar_size, char delim = ',');
+
+/**
+ * @brief Splits a string into an array of 8-bit unsigned integers based on a delimiter.
+ * @param str The input string to split.
+ * @param ar The output array to store uint8_t values.
+ * @param ar_size The size of the output array.
+ * @param delim The delimiter character (default: ',').
+ * @return Pointer to the output array, or NULL on error.
+ */
+extern uint8_t *split_u8(const char *str, uint8_t *ar, size_t ar_size, char delim = ',');
+
+/**
+ * @brief Splits the first str_len bytes of a buffer into an array of 8-bit unsigned integers based on a delimiter.
+ * @param str The input buffer; it does not need to be null-terminated and is not modified.
+ * @param str_len The number of bytes to split.
+ * @param ar The output array to store uint8_t values.
+ * @param ar_size The size of the output array.
+ * @param delim The delimiter character (default: ',').
+ * @return Pointer to the output array, or NULL on error.
+ */
+extern uint8_t *split_u8(const char *str, size_t str_len, uint8_t *ar, size_t ar_size, char delim = ',');
+
+/**
+ * @brief Splits a string into an array of 16-bit signed integers based on a delimiter.
+ * @param str The input string to split.
+ * @param ar The output array to store int16_t values.
+ * @param ar_size The size of the output array.
+ * @param delim The delimiter character (default: ',').
+ * @return Pointer to the output array, or NULL on error.
+ */
+extern int16_t *split_i16(const char *str, int16_t *ar, size_t ar_size, char delim = ',');
+
+/**
+ * @brief Splits the first str_len bytes of a buffer into an array of 16-bit signed integers based on a delimiter.
+ * @param str The input buffer; it does not need to be null-terminated and is not modified.
+ * @param str_len The number of bytes to split.
+ * @param ar The output array to store int16_t values.
+ * @param ar_size The size of the output array.
+ * @param delim The delimiter character (default: ',').
+ * @return Pointer to the output array, or NULL on error.
+ */
+extern int16_t *split_i16(const char *str, size_t str_len, int16_t *ar, size_t ar_size, char delim = ',');
+
+/**
+ * @brief Splits a string into an array of 16-bit unsigned integers based on a delimiter.
+ * @param str The input string to split.
+ * @param ar The output array to store uint16_t values.
+ * @param ar_size The size of the output array.
+ * @param delim The delimiter character (default: ',').
+ * @return Pointer to the output array, or NULL on error.
+ */
+extern uint16_t *split_u16(const char *str, uint16_t *ar, size_t ar_size, char delim = ',');
+
+/**
+ * @brief Splits the first str_len bytes of a buffer into an array of 16-bit unsigned integers based on a delimiter.
+ * @param str The input buffer; it does not need to be null-terminated and is not modified.
+ * @param str_len The number of bytes to split.
+ * @param ar The output array to store uint16_t values.
+ * @param ar_size The size of the output array.
+ * @param delim The delimiter character (default: ',').
+ * @return Pointer to the output array, or NULL on error.
+ */
+extern uint16_t *split_u16(const char *str, size_t str_len, uint16_t *ar, size_t ar_size, char delim = ',');
+
+/**
+ * @brief Splits a string into an array of 32-bit signed integers based on a delimiter.
+ * @param str The input string to split.
+ * @param ar The output array to store int32_t values.
+ * @param ar_size The size of the output array.
+ * @param delim The delimiter character (default: ',').
+ * @return Pointer to the output array, or NULL on error.
+ */
+extern int32_t *split_i32(const char *str, int32_t *ar, size_t ar_size, char delim = ',');
+
+/**
+ * @brief Splits the first str_len bytes of a buffer into an array of 32-bit signed integers based on a delimiter.
+ * @param str The input buffer; it does not need to be null-terminated and is not modified.
+ * @param str_len The number of bytes to split.
+ * @param ar The output array to store int32_t values.
+ * @param ar_size The size of the output array.
+ * @param delim The delimiter character (default: ',').
+ * @return Pointer to the output array, or NULL on error.
+ */
+extern int32_t *split_i32(const char *str, size_t str_len, int32_t *ar, size_t ar_size, char delim = ',');
+
+/**
+ * @brief Splits a string into an array of 32-bit unsigned integers based on a delimiter.
+ * @param str The input string to split.
+ * @param ar The output array to store uint32_t values.
+ * @param ar_size The size of the output array.
+ * @param delim The delimiter character (default: ',').
+ * @return Pointer to the output array, or NULL on error.
+ */
+extern uint32_t *split_u32(const char *str, uint32_t *ar, size_t ar_size, char delim = ',');
+
+/**
+ * @brief Splits the first str_len bytes of a buffer into an array of 32-bit unsigned integers based on a delimiter.
+ * @param str The input buffer; it does not need to be null-terminated and is not modified.
+ * @param str_len The number of bytes to split.
+ * @param ar The output array to store uint32_t values.
+ * @param ar_size The size of the output array.
+ * @param delim The delimiter character (default: ',').
+ * @return Pointer to the output array, or NULL on error.
+ */
+extern uint32_t *split_u32(const char *str, size_t str_len, uint32_t *ar, size_t ar_size, char delim = ',');
+
+/**
+ * @brief Splits a string into an array of 64-bit signed integers based on a delimiter.
+ * @param str The input string to split.
+ * @param ar The output array to store int64_t values.
+ * @param ar_size The size of the output array.
+ * @param delim The delimiter character (default: ',').
+ * @return Pointer to the output array, or NULL on error.
+ */
+extern int64_t *split_i64(const char *str, int64_t *ar, size_t ar_size, char delim = ',');
+
+/**
+ * @brief Splits the first str_len bytes of a buffer into an array of 64-bit signed integers based on a delimiter.
+ * @param str The input buffer; it does not need to be null-terminated and is not modified.
+ * @param str_len The number of bytes to split.
+ * @param ar The output array to store int64_t values.
+ * @param ar_size The size of the output array.
+ * @param delim The delimiter character (default: ',').
+ * @return Pointer to the output array, or NULL on error.
+ */
+extern int64_t *split_i64(const char *str, size_t str_len, int64_t *ar, size_t ar_size, char delim = ',');
+
+/**
+ * @brief Splits a string into an array of 64-bit unsigned integers based on a delimiter.
+ * @param str The input string to split.
+ * @param ar The output array to store uint64_t values.
+ * @param ar_size The size of the output array.
+ * @param delim The delimiter character (default: ',').
+ * @return Pointer to the output array, or NULL on error.
+ */
+extern uint64_t *split_u64(const char *str, uint64_t *ar, size_t ar_size, char delim = ',');
+
+/**
+ * @brief Splits the first str_len bytes of a buffer into an array of 64-bit unsigned integers based on a delimiter.
+ * @param str The input buffer; it does not need to be null-terminated and is not modified.
+ * @param str_len The number of bytes to split.
+ * @param ar The output array to store uint64_t values.
+ * @param ar_size The size of the output array.
+ * @param delim The delimiter character (default: ',').
+ * @return Pointer to the output array, or NULL on error.
+ */
+extern uint64_t *split_u64(const char *str, size_t str_len, uint64_t *ar, size_t ar_size, char delim = ',');
+
+/**
+ * @brief Splits a string into an array of floats based on a delimiter.
+ * @param str The input string to split.
+ * @param ar The output array to store float values.
+ * @param ar_size The size of the output array.
+ * @param d The decimal separator character (e.g., '.' or ',').
+ * @param delim The delimiter character (default: ',').
+ * @return Pointer to the output array, or NULL on error.
+ */
+extern float *split_float(const char *str, float *ar, size_t ar_size, char d, char delim = ',');
+
+/**
+ * @brief Splits the first str_len bytes of a buffer into an array of floats based on a delimiter.
+ * @param str The input buffer; it does not need to be null-terminated and is not modified.
+ * @param str_len The number of bytes to split.
+ * @param ar The output array to store float values.
+ * @param ar_size The size of the output array.
+ * @param d The decimal separator character.
+ * @param delim The delimiter character (default: ',').
+ * @return Pointer to the output array, or NULL on error.
+ */
+extern float *split_float(const char *str, size_t str_len, float *ar, size_t ar_size, char d, char delim = ',');
+
+/**
+ * @brief Splits a string into an array of doubles based on a delimiter.
+ * @param str The input string to split.
+ * @param ar The output array to store double values.
+ * @param ar_size The size of the output array.
+ * @param d The decimal separator character (e.g., '.' or ',').
+ * @param delim The delimiter character (default: ',').
+ * @return Pointer to the output array, or NULL on error.
+ */
+extern double *split_double(const char *str, double *ar, size_t ar_size, char d, char delim = ',');
+
+/**
+ * @brief Splits the first str_len bytes of a buffer into an array of doubles based on a delimiter.
+ * @param str The input buffer; it does not need to be null-terminated and is not modified.
+ * @param str_len The number of bytes to split.
+ * @param ar The output array to store double values.
+ * @param ar_size The size of the output array.
+ * @param d The decimal separator character.
+ * @param delim The delimiter character (default: ',').
+ * @return Pointer to the output array, or NULL on error.
+ */
+extern double *split_double(const char *str, size_t str_len, double *ar, size_t ar_size, char d, char delim = ',');
+
+/**
+ * @def VARINT_MAX
+ * @brief Maximum number of bytes of one varint (a 64-bit value).
+ */
+#define VARINT_MAX 10
+
+/**
+ * @brief Encodes a 8-bit unsigned integer as a varint (LEB128).
+ * @param num The value to encode.
+ * @param buf The output buffer.
+ * @param buf_size The size of the buffer.
+ * @return The number of bytes written, or 0 if the buffer is too small.
+ */
+extern size_t u8_to_varint(uint8_t num, uint8_t *buf, size_t buf_size);
+
+/**
+ * @brief Encodes a 8-bit signed integer as a varint (LEB128).
+ *
+ * Signed values are zigzag-encoded, so small negative numbers stay short.
+ * @param num The value to encode.
+ * @param buf The output buffer.
+ * @param buf_size The size of the buffer.
+ * @return The number of bytes written, or 0 if the buffer is too small.
  */
-extern uint64_t str_to_u64(const char *str, const char **endptr = nullptr, uint8_t base = 10);
+extern size_t i8_to_varint(int8_t num, uint8_t *buf, size_t buf_size);
 
 /**
- * @brief Converts a string to a double-precision floating-point number.
- * @param str The input string to parse.
- * @param d The decimal separator character (e.g., '.' or ',').
- * @param endptr Optional pointer to store the address of the first unparsed character.
- * @return The parsed double value, or 0.0 on error.
+ * @brief Encodes a 16-bit unsigned integer as a varint (LEB128).
+ * @param num The value to encode.
+ * @param buf The output buffer.
+ * @param buf_size The size of the buffer.
+ * @return The number of bytes written, or 0 if the buffer is too small.
  */
-extern double str_to_double(const char *str, char d = '.', const char **endptr = nullptr);
+extern size_t u16_to_varint(uint16_t num, uint8_t *buf, size_t buf_size);
 
 /**
- * @brief Reverses the characters in a string.
- * @param str The input string to reverse.
- * @return Pointer to the reversed string, or NULL on error.
+ * @brief Encodes a 16-bit signed integer as a varint (LEB128).
+ *
+ * Signed values are zigzag-encoded, so small negative numbers stay short.
+ * @param num The value to encode.
+ * @param buf The output buffer.
+ * @param buf_size The size of the buffer.
+ * @return The number of bytes written, or 0 if the buffer is too small.
  */
-extern char *str_reverse(char *str);
+extern size_t i16_to_varint(int16_t num, uint8_t *buf, size_t buf_size);
 
 /**
- * @brief Counts occurrences of a character in a string.
- * @param str The input string to search.
- * @param c The character to count.
- * @return The number of occurrences of the character.
+ * @brief Encodes a 32-bit unsigned integer as a varint (LEB128).
+ * @param num The value to encode.
+ * @param buf The output buffer.
+ * @param buf_size The size of the buffer.
+ * @return The number of bytes written, or 0 if the buffer is too small.
  */
-extern size_t chr_count(const char *str, char c);
+extern size_t u32_to_varint(uint32_t num, uint8_t *buf, size_t buf_size);
 
 /**
- * @brief Counts occurrences of a character in a string until str_len.
- * @param str The input string to search.
- * @param str_len The input until count the existing char.
- * @param c The character to count.
- * @return The number of occurrences of the character.
+ * @brief Encodes a 32-bit signed integer as a varint (LEB128).
+ *
+ * Signed values are zigzag-encoded, so small negative numbers stay short.
+ * @param num The value to encode.
+ * @param buf The output buffer.
+ * @param buf_size The size of the buffer.
+ * @return The number of bytes written, or 0 if the buffer is too small.
  */
-extern size_t chr_count(const char *str, size_t str_len, char c);
+extern size_t i32_to_varint(int32_t num, uint8_t *buf, size_t buf_size);
+
 /**
- * @brief Counts occurrences of a substring in a string.
- * @param str The input string to search.
- * @param find The substring to count.
- * @return The number of occurrences of the substring.
+ * @brief Encodes a 64-bit unsigned integer as a varint (LEB128).
+ * @param num The value to encode.
+ * @param buf The output buffer.
+ * @param buf_size The size of the buffer.
+ * @return The number of bytes written, or 0 if the buffer is too small.
  */
-extern size_t str_count(const char *str, const char *find);
+extern size_t u64_to_varint(uint64_t num, uint8_t *buf, size_t buf_size);
 
 /**
- * @brief Splits a string into an array of substrings based on a delimiter.
- * @param str The input string to split.
- * @param ar The output array to store substring pointers.
- * @param ar_size The size of the output array.
- * @param delim The delimiter character (default: ',').
+ * @brief Encodes a 64-bit signed integer as a varint (LEB128).
+ *
+ * Signed values are zigzag-encoded, so small negative numbers stay short.
+ * @param num The value to encode.
+ * @param buf The output buffer.
+ * @param buf_size The size of the buffer.
+ * @return The number of bytes written, or 0 if the buffer is too small.
  */
-extern const char **str_cut(char *str, const char **ar, size_t ar_size, char delim = ',');
+extern size_t i64_to_varint(int64_t num, uint8_t *buf, size_t buf_size);
 
 /**
- * @brief Joins an array of characters into a string with a delimiter.
- * @param ar The input array of characters.
+ * @brief Decodes a varint (LEB128) to a 8-bit unsigned integer.
+ * @param buf The input buffer.
+ * @param len The number of bytes available.
+ * @param endptr Optional pointer set past the varint, or to `buf` if it is truncated, too long or out of range.
+ * @return The decoded value, or 0 on error.
+ */
+extern uint8_t varint_to_u8(const uint8_t *buf, size_t len, const uint8_t **endptr = nullptr);
+
+/**
+ * @brief Decodes a varint (LEB128) to a 8-bit signed integer.
+ * @param buf The input buffer.
+ * @param len The number of bytes available.
+ * @param endptr Optional pointer set past the varint, or to `buf` if it is truncated, too long or out of range.
+ * @return The decoded value, or 0 on error.
+ */
+extern int8_t varint_to_i8(const uint8_t *buf, size_t len, const uint8_t **endptr = nullptr);
+
+/**
+ * @brief Decodes a varint (LEB128) to a 16-bit unsigned integer.
+ * @param buf The input buffer.
+ * @param len The number of bytes available.
+ * @param endptr Optional pointer set past the varint, or to `buf` if it is truncated, too long or out of range.
+ * @return The decoded value, or 0 on error.
+ */
+extern uint16_t varint_to_u16(const uint8_t *buf, size_t len, const uint8_t **endptr = nullptr);
+
+/**
+ * @brief Decodes a varint (LEB128) to a 16-bit signed integer.
+ * @param buf The input buffer.
+ * @param len The number of bytes available.
+ * @param endptr Optional pointer set past the varint, or to `buf` if it is truncated, too long or out of range.
+ * @return The decoded value, or 0 on error.
+ */
+extern int16_t varint_to_i16(const uint8_t *buf, size_t len, const uint8_t **endptr = nullptr);
+
+/**
+ * @brief Decodes a varint (LEB128) to a 32-bit unsigned integer.
+ * @param buf The input buffer.
+ * @param len The number of bytes available.
+ * @param endptr Optional pointer set past the varint, or to `buf` if it is truncated, too long or out of range.
+ * @return The decoded value, or 0 on error.
+ */
+extern uint32_t varint_to_u32(const uint8_t *buf, size_t len, const uint8_t **endptr = nullptr);
+
+/**
+ * @brief Decodes a varint (LEB128) to a 32-bit signed integer.
+ * @param buf The input buffer.
+ * @param len The number of bytes available.
+ * @param endptr Optional pointer set past the varint, or to `buf` if it is truncated, too long or out of range.
+ * @return The decoded value, or 0 on error.
+ */
+extern int32_t varint_to_i32(const uint8_t *buf, size_t len, const uint8_t **endptr = nullptr);
+
+/**
+ * @brief Decodes a varint (LEB128) to a 64-bit unsigned integer.
+ * @param buf The input buffer.
+ * @param len The number of bytes available.
+ * @param endptr Optional pointer set past the varint, or to `buf` if it is truncated, too long or out of range.
+ * @return The decoded value, or 0 on error.
+ */
+extern uint64_t varint_to_u64(const uint8_t *buf, size_t len, const uint8_t **endptr = nullptr);
+
+/**
+ * @brief Decodes a varint (LEB128) to a 64-bit signed integer.
+ * @param buf The input buffer.
+ * @param len The number of bytes available.
+ * @param endptr Optional pointer set past the varint, or to `buf` if it is truncated, too long or out of range.
+ * @return The decoded value, or 0 on error.
+ */
+extern int64_t varint_to_i64(const uint8_t *buf, size_t len, const uint8_t **endptr = nullptr);
+
+/**
+ * @brief Encodes an array of 8-bit unsigned integers as consecutive varints; the binary counterpart of join_u8().
+ * @param ar The input array.
  * @param ar_size The size of the input array.
- * @param buf The output string buffer.
+ * @param buf The output buffer.
  * @param buf_size The size of the buffer.
- * @param delim The delimiter character.
- * @return Pointer to the output string, or NULL on error.
+ * @return The number of bytes written, or 0 on error or if the buffer is too small.
  */
-extern char *join_chr_arr(const char *ar, size_t ar_size, char *buf, size_t buf_size, char delim);
+extern size_t join_varint_u8(const uint8_t *ar, size_t ar_size, uint8_t *buf, size_t buf_size);
 
 /**
- * @brief Joins an array of boolean values into a string with a delimiter.
- * @param ar The input array of boolean values.
+ * @brief Encodes an array of 8-bit signed integers as consecutive varints; the binary counterpart of join_i8().
+ * @param ar The input array.
  * @param ar_size The size of the input array.
- * @param buf The output string buffer.
+ * @param buf The output buffer.
  * @param buf_size The size of the buffer.
- * @param delim The delimiter character (default: ',').
- * @param t Optional string to represent true (default: "true").
- * @param f Optional string to represent false (default: "false").
- * @return Pointer to the output string, or NULL on error.
+ * @return The number of bytes written, or 0 on error or if the buffer is too small.
  */
-extern char *join_bool(const bool *ar, size_t ar_size, char *buf, size_t buf_size, char delim = ',', const char *t = nullptr, const char *f = nullptr);
+extern size_t join_varint_i8(const int8_t *ar, size_t ar_size, uint8_t *buf, size_t buf_size);
 
 /**
- * @brief Joins an array of 8-bit signed integers into a string with a delimiter.
- * @param ar The input array of int8_t values.
+ * @brief Encodes an array of 16-bit unsigned integers as consecutive varints; the binary counterpart of join_u16().
+ * @param ar The input array.
  * @param ar_size The size of the input array.
- * @param buf The output string buffer.
+ * @param buf The output buffer.
  * @param buf_size The size of the buffer.
- * @param delim The delimiter character (default: ',').
- * @param base The numerical base (default: 10).
- * @return Pointer to the output string, or NULL on error.
+ * @return The number of bytes written, or 0 on error or if the buffer is too small.
  */
-extern char *join_i8(const int8_t *ar, size_t ar_size, char *buf, size_t buf_size, char delim = ',', uint8_t base = 10);
+extern size_t join_varint_u16(const uint16_t *ar, size_t ar_size, uint8_t *buf, size_t buf_size);
 
 /**
- * @brief Joins an array of 8-bit unsigned integers into a string with a delimiter.
- * @param ar The input array of uint8_t values.
+ * @brief Encodes an array of 16-bit signed integers as consecutive varints; the binary counterpart of join_i16().
+ * @param ar The input array.
  * @param ar_size The size of the input array.
- * @param buf The output string buffer.
+ * @param buf The output buffer.
  * @param buf_size The size of the buffer.
- * @param delim The delimiter character (default: ',').
- * @param base The numerical base (default: 10).
- * @return Pointer to the output string, or NULL on error.
+ * @return The number of bytes written, or 0 on error or if the buffer is too small.
  */
-extern char *join_u8(const uint8_t *ar, size_t ar_size, char *buf, size_t buf_size, char delim = ',', uint8_t base = 10);
+extern size_t join_varint_i16(const int16_t *ar, size_t ar_size, uint8_t *buf, size_t buf_size);
 
 /**
- * @brief Joins an array of 16-bit signed integers into a string with a delimiter.
- * @param ar The input array of int16_t values.
+ * @brief Encodes an array of 32-bit unsigned integers as consecutive varints; the binary counterpart of join_u32().
+ * @param ar The input array.
  * @param ar_size The size of the input array.
- * @param buf The output string buffer.
+ * @param buf The output buffer.
  * @param buf_size The size of the buffer.
- * @param delim The delimiter character (default: ',').
- * @param base The numerical base (default: 10).
- * @return Pointer to the output string, or NULL on error.
+ * @return The number of bytes written, or 0 on error or if the buffer is too small.
  */
-extern char *join_i16(const int16_t *ar, size_t ar_size, char *buf, size_t buf_size, char delim = ',', uint8_t base = 10);
+extern size_t join_varint_u32(const uint32_t *ar, size_t ar_size, uint8_t *buf, size_t buf_size);
 
 /**
- * @brief Joins an array of 16-bit unsigned integers into a string with a delimiter.
- * @param ar The input array of uint16_t values.
+ * @brief Encodes an array of 32-bit signed integers as consecutive varints; the binary counterpart of join_i32().
+ * @param ar The input array.
  * @param ar_size The size of the input array.
- * @param buf The output string buffer.
+ * @param buf The output buffer.
  * @param buf_size The size of the buffer.
- * @param delim The delimiter character (default: ',').
- * @param base The numerical base (default: 10).
- * @return Pointer to the output string, or NULL on error.
+ * @return The number of bytes written, or 0 on error or if the buffer is too small.
  */
-extern char *join_u16(const uint16_t *ar, size_t ar_size, char *buf, size_t buf_size, char delim = ',', uint8_t base = 10);
+extern size_t join_varint_i32(const int32_t *ar, size_t ar_size, uint8_t *buf, size_t buf_size);
 
 /**
- * @brief Joins an array of 32-bit signed integers into a string with a delimiter.
- * @param ar The input array of int32_t values.
+ * @brief Encodes an array of 64-bit unsigned integers as consecutive varints; the binary counterpart of join_u64().
+ * @param ar The input array.
  * @param ar_size The size of the input array.
- * @param buf The output string buffer.
+ * @param buf The output buffer.
  * @param buf_size The size of the buffer.
- * @param delim The delimiter character (default: ',').
- * @param base The numerical base (default: 10).
- * @return Pointer to the output string, or NULL on error.
+ * @return The number of bytes written, or 0 on error or if the buffer is too small.
  */
-extern char *join_i32(const int32_t *ar, size_t ar_size, char *buf, size_t buf_size, char delim = ',', uint8_t base = 10);
+extern size_t join_varint_u64(const uint64_t *ar, size_t ar_size, uint8_t *buf, size_t buf_size);
 
 /**
- * @brief Joins an array of 32-bit unsigned integers into a string with a delimiter.
- * @param ar The input array of uint32_t values.
+ * @brief Encodes an array of 64-bit signed integers as consecutive varints; the binary counterpart of join_i64().
+ * @param ar The input array.
  * @param ar_size The size of the input array.
- * @param buf The output string buffer.
+ * @param buf The output buffer.
  * @param buf_size The size of the buffer.
- * @param delim The delimiter character (default: ',').
- * @param base The numerical base (default: 10).
- * @return Pointer to the output string, or NULL on error.
+ * @return The number of bytes written, or 0 on error or if the buffer is too small.
  */
-extern char *join_u32(const uint32_t *ar, size_t ar_size, char *buf, size_t buf_size, char delim = ',', uint8_t base = 10);
+extern size_t join_varint_i64(const int64_t *ar, size_t ar_size, uint8_t *buf, size_t buf_size);
 
 /**
- * @brief Joins an array of 64-bit signed integers into a string with a delimiter.
- * @param ar The input array of int64_t values.
+ * @brief Decodes consecutive varints into an array of 8-bit unsigned integers; the binary counterpart of split_u8().
+ * @param buf The input buffer.
+ * @param len The number of bytes in the buffer.
+ * @param ar The output array.
+ * @param ar_size The size of the output array; decoding stops when it is full.
+ * @return The number of values decoded, or 0 if a varint is truncated or out of range.
+ */
+extern size_t split_varint_u8(const uint8_t *buf, size_t len, uint8_t *ar, size_t ar_size);
+
+/**
+ * @brief Decodes consecutive varints into an array of 8-bit signed integers; the binary counterpart of split_i8().
+ * @param buf The input buffer.
+ * @param len The number of bytes in the buffer.
+ * @param ar The output array.
+ * @param ar_size The size of the output array; decoding stops when it is full.
+ * @return The number of values decoded, or 0 if a varint is truncated or out of range.
+ */
+extern size_t split_varint_i8(const uint8_t *buf, size_t len, int8_t *ar, size_t ar_size);
+
+/**
+ * @brief Decodes consecutive varints into an array of 16-bit unsigned integers; the binary counterpart of split_u16().
+ * @param buf The input buffer.
+ * @param len The number of bytes in the buffer.
+ * @param ar The output array.
+ * @param ar_size The size of the output array; decoding stops when it is full.
+ * @return The number of values decoded, or 0 if a varint is truncated or out of range.
+ */
+extern size_t split_varint_u16(const uint8_t *buf, size_t len, uint16_t *ar, size_t ar_size);
+
+/**
+ * @brief Decodes consecutive varints into an array of 16-bit signed integers; the binary counterpart of split_i16().
+ * @param buf The input buffer.
+ * @param len The number of bytes in the buffer.
+ * @param ar The output array.
+ * @param ar_size The size of the output array; decoding stops when it is full.
+ * @return The number of values decoded, or 0 if a varint is truncated or out of range.
+ */
+extern size_t split_varint_i16(const uint8_t *buf, size_t len, int16_t *ar, size_t ar_size);
+
+/**
+ * @brief Decodes consecutive varints into an array of 32-bit unsigned integers; the binary counterpart of split_u32().
+ * @param buf The input buffer.
+ * @param len The number of bytes in the buffer.
+ * @param ar The output array.
+ * @param ar_size The size of the output array; decoding stops when it is full.
+ * @return The number of values decoded, or 0 if a varint is truncated or out of range.
+ */
+extern size_t split_varint_u32(const uint8_t *buf, size_t len, uint32_t *ar, size_t ar_size);
+
+/**
+ * @brief Decodes consecutive varints into an array of 32-bit signed integers; the binary counterpart of split_i32().
+ * @param buf The input buffer.
+ * @param len The number of bytes in the buffer.
+ * @param ar The output array.
+ * @param ar_size The size of the output array; decoding stops when it is full.
+ * @return The number of values decoded, or 0 if a varint is truncated or out of range.
+ */
+extern size_t split_varint_i32(const uint8_t *buf, size_t len, int32_t *ar, size_t ar_size);
+
+/**
+ * @brief Decodes consecutive varints into an array of 64-bit unsigned integers; the binary counterpart of split_u64().
+ * @param buf The input buffer.
+ * @param len The number of bytes in the buffer.
+ * @param ar The output array.
+ * @param ar_size The size of the output array; decoding stops when it is full.
+ * @return The number of values decoded, or 0 if a varint is truncated or out of range.
+ */
+extern size_t split_varint_u64(const uint8_t *buf, size_t len, uint64_t *ar, size_t ar_size);
+
+/**
+ * @brief Decodes consecutive varints into an array of 64-bit signed integers; the binary counterpart of split_i64().
+ * @param buf The input buffer.
+ * @param len The number of bytes in the buffer.
+ * @param ar The output array.
+ * @param ar_size The size of the output array; decoding stops when it is full.
+ * @return The number of values decoded, or 0 if a varint is truncated or out of range.
+ */
+extern size_t split_varint_i64(const uint8_t *buf, size_t len, int64_t *ar, size_t ar_size);
+
+/**
+ * @def PACKED_MAX
+ * @brief Worst-case bytes written by join_packed_*() for `n` values of `size` bytes each.
+ */
+#define PACKED_MAX(n, size) ((size_t)(n) * (size) + 14 * (((size_t)(n) + 31) / 32))
+
+/**
+ * @brief Delta-encodes and bit-packs an array of 8-bit unsigned integers in blocks.
+ *
+ * Each block stores its first value, the smallest delta and the remaining deltas
+ * minus that smallest one at the minimal bit width for the block. The output never
+ * exceeds PACKED_MAX(ar_size, 1) bytes.
+ * @param ar The input array.
  * @param ar_size The size of the input array.
- * @param buf The output string buffer.
+ * @param buf The output buffer.
  * @param buf_size The size of the buffer.
- * @param delim The delimiter character (default: ',').
- * @param base The numerical base (default: 10).
- * @return Pointer to the output string, or NULL on error.
+ * @param block The number of values per block: 32 or 128 (default: 128).
+ * @return The number of bytes written, or 0 on error or if the buffer is too small.
+ */
+extern size_t join_packed_u8(const uint8_t *ar, size_t ar_size, uint8_t *buf, size_t buf_size, uint8_t block = 128);
+
+/**
+ * @brief Delta-encodes and bit-packs an array of 8-bit signed integers in blocks.
+ *
+ * Each block stores its first value, the smallest delta and the remaining deltas
+ * minus that smallest one at the minimal bit width for the block. The output never
+ * exceeds PACKED_MAX(ar_size, 1) bytes.
+ * @param ar The input array.
+ * @param ar_size The size of the input array.
+ * @param buf The output buffer.
+ * @param buf_size The size of the buffer.
+ * @param block The number of values per block: 32 or 128 (default: 128).
+ * @return The number of bytes written, or 0 on error or if the buffer is too small.
+ */
+extern size_t join_packed_i8(const int8_t *ar, size_t ar_size, uint8_t *buf, size_t buf_size, uint8_t block = 128);
+
+/**
+ * @brief Delta-encodes and bit-packs an array of 16-bit unsigned integers in blocks.
+ *
+ * Each block stores its first value, the smallest delta and the remaining deltas
+ * minus that smallest one at the minimal bit width for the block. The output never
+ * exceeds PACKED_MAX(ar_size, 2) bytes.
+ * @param ar The input array.
+ * @param ar_size The size of the input array.
+ * @param buf The output buffer.
+ * @param buf_size The size of the buffer.
+ * @param block The number of values per block: 32 or 128 (default: 128).
+ * @return The number of bytes written, or 0 on error or if the buffer is too small.
+ */
+extern size_t join_packed_u16(const uint16_t *ar, size_t ar_size, uint8_t *buf, size_t buf_size, uint8_t block = 128);
+
+/**
+ * @brief Delta-encodes and bit-packs an array of 16-bit signed integers in blocks.
+ *
+ * Each block stores its first value, the smallest delta and the remaining deltas
+ * minus that smallest one at the minimal bit width for the block. The output never
+ * exceeds PACKED_MAX(ar_size, 2) bytes.
+ * @param ar The input array.
+ * @param ar_size The size of the input array.
+ * @param buf The output buffer.
+ * @param buf_size The size of the buffer.
+ * @param block The number of values per block: 32 or 128 (default: 128).
+ * @return The number of bytes written, or 0 on error or if the buffer is too small.
+ */
+extern size_t join_packed_i16(const int16_t *ar, size_t ar_size, uint8_t *buf, size_t buf_size, uint8_t block = 128);
+
+/**
+ * @brief Delta-encodes and bit-packs an array of 32-bit unsigned integers in blocks.
+ *
+ * Each block stores its first value, the smallest delta and the remaining deltas
+ * minus that smallest one at the minimal bit width for the block. The output never
+ * exceeds PACKED_MAX(ar_size, 4) bytes.
+ * @param ar The input array.
+ * @param ar_size The size of the input array.
+ * @param buf The output buffer.
+ * @param buf_size The size of the buffer.
+ * @param block The number of values per block: 32 or 128 (default: 128).
+ * @return The number of bytes written, or 0 on error or if the buffer is too small.
+ */
+extern size_t join_packed_u32(const uint32_t *ar, size_t ar_size, uint8_t *buf, size_t buf_size, uint8_t block = 128);
+
+/**
+ * @brief Delta-encodes and bit-packs an array of 32-bit signed integers in blocks.
+ *
+ * Each block stores its first value, the smallest delta and the remaining deltas
+ * minus that smallest one at the minimal bit width for the block. The output never
+ * exceeds PACKED_MAX(ar_size, 4) bytes.
+ * @param ar The input array.
+ * @param ar_size The size of the input array.
+ * @param buf The output buffer.
+ * @param buf_size The size of the buffer.
+ * @param block The number of values per block: 32 or 128 (default: 128).
+ * @return The number of bytes written, or 0 on error or if the buffer is too small.
+ */
+extern size_t join_packed_i32(const int32_t *ar, size_t ar_size, uint8_t *buf, size_t buf_size, uint8_t block = 128);
+
+/**
+ * @brief Delta-encodes and bit-packs an array of 64-bit unsigned integers in blocks.
+ *
+ * Each block stores its first value, the smallest delta and the remaining deltas
+ * minus that smallest one at the minimal bit width for the block. The output never
+ * exceeds PACKED_MAX(ar_size, 8) bytes.
+ * @param ar The input array.
+ * @param ar_size The size of the input array.
+ * @param buf The output buffer.
+ * @param buf_size The size of the buffer.
+ * @param block The number of values per block: 32 or 128 (default: 128).
+ * @return The number of bytes written, or 0 on error or if the buffer is too small.
+ */
+extern size_t join_packed_u64(const uint64_t *ar, size_t ar_size, uint8_t *buf, size_t buf_size, uint8_t block = 128);
+
+/**
+ * @brief Delta-encodes and bit-packs an array of 64-bit signed integers in blocks.
+ *
+ * Each block stores its first value, the smallest delta and the remaining deltas
+ * minus that smallest one at the minimal bit width for the block. The output never
+ * exceeds PACKED_MAX(ar_size, 8) bytes.
+ * @param ar The input array.
+ * @param ar_size The size of the input array.
+ * @param buf The output buffer.
+ * @param buf_size The size of the buffer.
+ * @param block The number of values per block: 32 or 128 (default: 128).
+ * @return The number of bytes written, or 0 on error or if the buffer is too small.
+ */
+extern size_t join_packed_i64(const int64_t *ar, size_t ar_size, uint8_t *buf, size_t buf_size, uint8_t block = 128);
+
+/**
+ * @brief Decodes blocks written by join_packed_u8() into an array of 8-bit unsigned integers.
+ * @param buf The input buffer.
+ * @param len The number of bytes in the buffer.
+ * @param ar The output array.
+ * @param ar_size The size of the output array; decoding stops when it is full.
+ * @return The number of values decoded, or 0 if a block is malformed or truncated.
+ */
+extern size_t split_packed_u8(const uint8_t *buf, size_t len, uint8_t *ar, size_t ar_size);
+
+/**
+ * @brief Decodes blocks written by join_packed_i8() into an array of 8-bit signed integers.
+ * @param buf The input buffer.
+ * @param len The number of bytes in the buffer.
+ * @param ar The output array.
+ * @param ar_size The size of the output array; decoding stops when it is full.
+ * @return The number of values decoded, or 0 if a block is malformed or truncated.
+ */
+extern size_t split_packed_i8(const uint8_t *buf, size_t len, int8_t *ar, size_t ar_size);
+
+/**
+ * @brief Decodes blocks written by join_packed_u16() into an array of 16-bit unsigned integers.
+ * @param buf The input buffer.
+ * @param len The number of bytes in the buffer.
+ * @param ar The output array.
+ * @param ar_size The size of the output array; decoding stops when it is full.
+ * @return The number of values decoded, or 0 if a block is malformed or truncated.
+ */
+extern size_t split_packed_u16(const uint8_t *buf, size_t len, uint16_t *ar, size_t ar_size);
+
+/**
+ * @brief Decodes blocks written by join_packed_i16() into an array of 16-bit signed integers.
+ * @param buf The input buffer.
+ * @param len The number of bytes in the buffer.
+ * @param ar The output array.
+ * @param ar_size The size of the output array; decoding stops when it is full.
+ * @return The number of values decoded, or 0 if a block is malformed or truncated.
+ */
+extern size_t split_packed_i16(const uint8_t *buf, size_t len, int16_t *ar, size_t ar_size);
+
+/**
+ * @brief Decodes blocks written by join_packed_u32() into an array of 32-bit unsigned integers.
+ * @param buf The input buffer.
+ * @param len The number of bytes in the buffer.
+ * @param ar The output array.
+ * @param ar_size The size of the output array; decoding stops when it is full.
+ * @return The number of values decoded, or 0 if a block is malformed or truncated.
+ */
+extern size_t split_packed_u32(const uint8_t *buf, size_t len, uint32_t *ar, size_t ar_size);
+
+/**
+ * @brief Decodes blocks written by join_packed_i32() into an array of 32-bit signed integers.
+ * @param buf The input buffer.
+ * @param len The number of bytes in the buffer.
+ * @param ar The output array.
+ * @param ar_size The size of the output array; decoding stops when it is full.
+ * @return The number of values decoded, or 0 if a block is malformed or truncated.
+ */
+extern size_t split_packed_i32(const uint8_t *buf, size_t len, int32_t *ar, size_t ar_size);
+
+/**
+ * @brief Decodes blocks written by join_packed_u64() into an array of 64-bit unsigned integers.
+ * @param buf The input buffer.
+ * @param len The number of bytes in the buffer.
+ * @param ar The output array.
+ * @param ar_size The size of the output array; decoding stops when it is full.
+ * @return The number of values decoded, or 0 if a block is malformed or truncated.
+ */
+extern size_t split_packed_u64(const uint8_t *buf, size_t len, uint64_t *ar, size_t ar_size);
+
+/**
+ * @brief Decodes blocks written by join_packed_i64() into an array of 64-bit signed integers.
+ * @param buf The input buffer.
+ * @param len The number of bytes in the buffer.
+ * @param ar The output array.
+ * @param ar_size The size of the output array; decoding stops when it is full.
+ * @return The number of values decoded, or 0 if a block is malformed or truncated.
+ */
+extern size_t split_packed_i64(const uint8_t *buf, size_t len, int64_t *ar, size_t ar_size);
+
+/**
+ * @brief Zigzag-encodes a signed 32-bit value: 0, -1, 1, -2, ... become 0, 1, 2, 3, ...
+ * @param v The signed value.
+ * @return The encoded value.
+ */
+static constexpr uint32_t zigzag32(int32_t v);
+
+/**
+ * @brief Zigzag-encodes a signed 64-bit value.
+ * @param v The signed value.
+ * @return The encoded value.
+ */
+static constexpr uint64_t zigzag64(int64_t v);
+
+/**
+ * @brief Decodes a zigzag-encoded 32-bit value.
+ * @param v The encoded value.
+ * @return The signed value.
+ */
+static constexpr int32_t unzigzag32(uint32_t v);
+
+/**
+ * @brief Decodes a zigzag-encoded 64-bit value.
+ * @param v The encoded value.
+ * @return The signed value.
+ */
+static constexpr int64_t unzigzag64(uint64_t v);
+
+/**
+ * @brief Checks whether a given character sequence represents a valid number.
+ *
+ * This function examines a substring of a given C string and determines whether
+ * it represents a valid integer: decimal digits with an optional leading '+' or '-' sign.
+ *
+ * No whitespace, decimal point, exponential notation (e.g., '1e5'), or thousands
+ * separators are supported; use num_classify() for those.
+ *
+ * @param str Pointer to the character buffer to examine.
+ * @param len Length of the substring to check.
+ *
+ * @return true if the substring is a valid number, false otherwise.
  */
-extern char *join_i64(const int64_t *ar, size_t ar_size, char *buf, size_t buf_size, char delim = ',', uint8_t base = 10);
+extern bool is_number(const char *str, size_t len);
 
 /**
- * @brief Joins an array of 64-bit unsigned integers into a string with a delimiter.
- * @param ar The input array of uint64_t values.
- * @param ar_size The size of the input array.
- * @param buf The output string buffer.
- * @param buf_size The size of the buffer.
- * @param delim The delimiter character (default: ',').
- * @param base The numerical base (default: 10).
- * @return Pointer to the output string, or NULL on error.
+ * @enum num_kind
+ * @brief Kind of number detected by num_classify().
  */
-extern char *join_u64(const uint64_t *ar, size_t ar_size, char *buf, size_t buf_size, char delim = ',', uint8_t base = 10);
+enum num_kind : uint8_t {
+  NUM_INVALID = 0,  ///< Not a number.
+  NUM_INT,          ///< Decimal integer, e.g. "-42".
+  NUM_DEC,          ///< Decimal with a fraction, e.g. "3.14" or ".5".
+  NUM_EXP,          ///< Decimal with an exponent, e.g. "6.02e23".
+  NUM_HEX,          ///< Hexadecimal with a 0x prefix, e.g. "0x1F".
+  NUM_INF,          ///< "inf" or "infinity", any case.
+  NUM_NAN           ///< "nan", any case.
+};
 
 /**
- * @brief Joins an array of floats into a string with a delimiter.
- * @param ar The input array of float values.
- * @param ar_size The size of the input array.
- * @param buf The output string buffer.
- * @param buf_size The size of the buffer.
- * @param dec The number of decimal places.
- * @param delim The delimiter character (default: ',').
- * @return Pointer to the output string, or NULL on error.
+ * @brief Validates and classifies a number in a character sequence.
+ *
+ * The whole span must be one number with an optional leading sign; no whitespace
+ * is allowed. Runs of digits are checked a block at a time. The kind and digit count
+ * let the caller pick a conversion without validating again, e.g. str_to_u32() when
+ * the result is NUM_INT with at most 9 digits.
+ *
+ * @param str Pointer to the character buffer to examine; it does not need to be null-terminated.
+ * @param len Length of the number.
+ * @param digits Optional output receiving the number of mantissa digits (hex digits for
+ *               NUM_HEX; 0 for NUM_INF, NUM_NAN and NUM_INVALID). May be NULL.
+ * @param d The decimal separator character (default: '.').
+ * @return The kind of number, or NUM_INVALID.
  */
-extern char *join_float(const float *ar, size_t ar_size, char *buf, size_t buf_size, uint8_t dec, char delim = ',');
+extern num_kind num_classify(const char *str, size_t len, size_t *digits = nullptr, char d = '.');
 
 /**
- * @brief Joins an array of doubles into a string with a delimiter.
- * @param ar The input array of double values.
- * @param ar_size The size of the input array.
- * @param buf The output string buffer.
- * @param buf_size The size of the buffer.
- * @param dec The number of decimal places.
- * @param delim The delimiter character (default: ',').
- * @return Pointer to the output string, or NULL on error.
+ * @brief Finds the end of a quoted JSON string.
+ *
+ * Scans the given string starting from the first double quote (`"`) and returns
+ * a pointer to the character after the closing quote. Handles escaped quotes (e.g., `\"`) correctly.
+ *
+ * @param str Pointer to the string starting at a double quote (`"`).
+ * @return Pointer to the character immediately after the closing quote, or NULL if unterminated.
  */
-extern char *join_double(const double *ar, size_t ar_size, char *buf, size_t buf_size, uint8_t dec, char delim = ',');
+extern const char *str_end(const char *str);
 
 /**
- * @brief Joins an array of strings into a single string with a delimiter.
- * @param ar The input array of strings.
- * @param ar_size The size of the input array.
- * @param buf The output string buffer.
- * @param buf_size The size of the buffer.
- * @param delim The delimiter character (default: ',').
- * @return Pointer to the output string, or NULL on error.
+ * @brief Skips over whitespace characters in a string.
+ *
+ * Advances the pointer past any leading whitespace characters such as space, tab,
+ * carriage return, or newline.
+ *
+ * @param str Pointer to the start of the string to be scanned.
+ * @return Pointer to the first non-whitespace character.
  */
-extern char *join_str(const char **ar, size_t ar_size, char *buf, size_t buf_size, char delim = ',');
+extern const char *str_ignore(const char *str);
 
 /**
- * @brief Splits a string into an array of boolean values based on a delimiter.
- * @param str The input string to split.
- * @param ar The output array to store boolean values.
- * @param ar_size The size of the output array.
- * @param delim The delimiter character (default: ',').
- * @param t Optional string to represent true (default: "true").
- * @param f Optional string to represent false (default: "false").
- * @return Pointer to the output array, or NULL on error.
+ * @brief Skips whitespace within the first str_len bytes of a buffer.
+ * @param str The input buffer; it does not need to be null-terminated.
+ * @param str_len The number of bytes available.
+ * @return Pointer to the first non-whitespace character, `str + str_len` if there is none, or NULL on error.
  */
-extern bool *split_bool(const char *str, bool *ar, size_t ar_size, char delim = ',', const char *t = nullptr, const char *f = nullptr);
+extern const char *str_ignore(const char *str, size_t str_len);
 
 /**
- * @brief Splits a string into an array of characters based on a delimiter.
- * @param str The input string to split.
- * @param ar The output array to store characters.
- * @param ar_size The size of the output array.
- * @param delim The delimiter character (default: ',').
- * @return Pointer to the output array, or NULL on error.
+ * @brief Finds the matching closing bracket or brace in a JSON structure.
+ *
+ * Traverses the string from the current position to locate the end of an array (`[]`)
+ * or object (`{}`), accounting for nested structures. Brackets inside strings are ignored.
+ *
+ * @param str Pointer to the opening bracket (`[` or `{`) in the string.
+ * @return Pointer to the matching closing bracket (`]` or `}`), or NULL if not found.
  */
-extern char *split_chr(const char *str, char *ar, size_t ar_size, char delim = ',');
+extern const char *br_end(const char *str);
 
 /**
- * @brief Splits a string into tokens based on a delimiter, extracting only quoted substrings.
+ * @brief Finds the end of a simple JSON value by locating the next comma, brace, or bracket.
  *
- * This function processes an input string, extracts substrings enclosed in double quotes (`"`), and stores them in a destination buffer.
- * The extracted tokens are referenced by an array of pointers (`ar`). Non-quoted parts of the string are ignored, and the function supports
- * escaped quotes (`\"`) and backslashes (`\\`) within quoted strings. The destination buffer can be the same as the input string for in-place processing.
+ * Useful for parsing primitive values such as numbers, booleans, or null, by identifying
+ * the boundary of the value token.
  *
- * @param str The input string to process (null-terminated).
- * @param dest The destination buffer where extracted tokens are stored.
- * @param dest_size The size of the destination buffer (including space for null terminators).
- * @param ar Array of pointers to store the starting addresses of extracted tokens.
- * @param ar_size The size of the `ar` array (maximum number of tokens to extract).
- * @param delim The delimiter character to separate tokens (default: ',').
+ * @param str Pointer to the beginning of the JSON value.
+ * @return Pointer to the first delimiter character (`,`, `}`, or `]`) or NULL if not found.
+ */
+extern const char *coma_end(const char *str);
+
+/**
+ * @brief Locates a single value in a JSON document by key path, without parsing the rest.
  *
- * @return Pointer to the destination buffer (`dest`) on success, or `NULL` if any input parameter is invalid
- *         (`str`, `dest`, or `ar` is `NULL`, or `dest_size` or `ar_size` is 0).
+ * The path is a sequence of object keys separated by `.` and array indices in
+ * brackets, e.g. `"cfg.rate"`, `"values[3]"` or `"nodes[0].id"`. Unwanted members and
+ * elements are skipped whole with str_end() and br_end(); nothing is copied or allocated.
+ * The returned span can be passed straight to str_to_i32(), str_to_double() and friends.
  *
- * @note The function modifies the `dest` buffer and may overwrite the input string if `str` and `dest` are the same.
- * @note The caller must ensure `dest_size` is sufficient to hold all extracted tokens plus null terminators.
- * @note Tokens exceeding `ar_size` are ignored, and the function stops processing if the `dest` buffer is full.
- * @warning Ensure `dest_size` is large enough to avoid buffer overflow, especially in memory-constrained environments like Arduino.
+ * @param str The JSON text (null-terminated).
+ * @param path The key path to look up.
+ * @param len Optional pointer receiving the length of the value (quotes included for strings).
+ * @return Pointer to the first character of the value, or NULL if the path does not exist.
  */
-extern char *split_quoted_str(const char *str, char *dest, size_t dest_size, const char **ar, size_t ar_size, char delim = ',');
+extern const char *json_path(const char *str, const char *path, size_t *len = nullptr);
 
-extern const char **split_str(const char *str, char *dest, size_t dest_size, const char **ar, size_t ar_size, char delim = ',');
+/**
+ * @brief Reads a JSON array of booleans in one pass.
+ *
+ * Starts at `[` (leading whitespace allowed), parses each element and stops at the
+ * matching `]`, without a separate br_end() scan or a copy of the array text.
+ *
+ * @param str Pointer to the array in the JSON text.
+ * @param ar The output array.
+ * @param ar_size The size of the output array.
+ * @param endptr Optional pointer receiving the position after `]` (or `str` on error).
+ * @return The number of elements in the JSON array (only the first `ar_size` are stored),
+ *         or 0 on error.
+ */
+extern size_t json_arr_bool(const char *str, bool *ar, size_t ar_size, const char **endptr = nullptr);
 
 /**
- * @brief Splits a string into an array of 8-bit signed integers based on a delimiter.
- * @param str The input string to split.
- * @param ar The output array to store int8_t values.
+ * @brief Reads a JSON array of 8-bit signed integers in one pass (see json_arr_bool()).
+ * @param str Pointer to the array in the JSON text.
+ * @param ar The output array.
  * @param ar_size The size of the output array.
- * @param delim The delimiter character (default: ',').
- * @return Pointer to the output array, or NULL on error.
+ * @param endptr Optional pointer receiving the position after `]` (or `str` on error).
+ * @return The number of elements in the JSON array, or 0 on error.
  */
-extern int8_t *split_i8(const char *str, int8_t *ar, size_t ar_size, char delim = ',');
+extern size_t json_arr_i8(const char *str, int8_t *ar, size_t ar_size, const char **endptr = nullptr);
 
 /**
- * @brief Splits a string into an array of 8-bit unsigned integers based on a delimiter.
- * @param str The input string to split.
- * @param ar The output array to store uint8_t values.
+ * @brief Reads a JSON array of 8-bit unsigned integers in one pass (see json_arr_bool()).
+ * @param str Pointer to the array in the JSON text.
+ * @param ar The output array.
  * @param ar_size The size of the output array.
- * @param delim The delimiter character (default: ',').
- * @return Pointer to the output array, or NULL on error.
+ * @param endptr Optional pointer receiving the position after `]` (or `str` on error).
+ * @return The number of elements in the JSON array, or 0 on error.
  */
-extern uint8_t *split_u8(const char *str, uint8_t *ar, size_t ar_size, char delim = ',');
+extern size_t json_arr_u8(const char *str, uint8_t *ar, size_t ar_size, const char **endptr = nullptr);
 
 /**
- * @brief Splits a string into an array of 16-bit signed integers based on a delimiter.
- * @param str The input string to split.
- * @param ar The output array to store int16_t values.
+ * @brief Reads a JSON array of 16-bit signed integers in one pass (see json_arr_bool()).
+ * @param str Pointer to the array in the JSON text.
+ * @param ar The output array.
  * @param ar_size The size of the output array.
- * @param delim The delimiter character (default: ',').
- * @return Pointer to the output array, or NULL on error.
+ * @param endptr Optional pointer receiving the position after `]` (or `str` on error).
+ * @return The number of elements in the JSON array, or 0 on error.
  */
-extern int16_t *split_i16(const char *str, int16_t *ar, size_t ar_size, char delim = ',');
+extern size_t json_arr_i16(const char *str, int16_t *ar, size_t ar_size, const char **endptr = nullptr);
 
 /**
- * @brief Splits a string into an array of 16-bit unsigned integers based on a delimiter.
- * @param str The input string to split.
- * @param ar The output array to store uint16_t values.
+ * @brief Reads a JSON array of 16-bit unsigned integers in one pass (see json_arr_bool()).
+ * @param str Pointer to the array in the JSON text.
+ * @param ar The output array.
  * @param ar_size The size of the output array.
- * @param delim The delimiter character (default: ',').
- * @return Pointer to the output array, or NULL on error.
+ * @param endptr Optional pointer receiving the position after `]` (or `str` on error).
+ * @return The number of elements in the JSON array, or 0 on error.
  */
-extern uint16_t *split_u16(const char *str, uint16_t *ar, size_t ar_size, char delim = ',');
+extern size_t json_arr_u16(const char *str, uint16_t *ar, size_t ar_size, const char **endptr = nullptr);
 
 /**
- * @brief Splits a string into an array of 32-bit signed integers based on a delimiter.
- * @param str The input string to split.
- * @param ar The output array to store int32_t values.
+ * @brief Reads a JSON array of 32-bit signed integers in one pass (see json_arr_bool()).
+ * @param str Pointer to the array in the JSON text.
+ * @param ar The output array.
  * @param ar_size The size of the output array.
- * @param delim The delimiter character (default: ',').
- * @return Pointer to the output array, or NULL on error.
+ * @param endptr Optional pointer receiving the position after `]` (or `str` on error).
+ * @return The number of elements in the JSON array, or 0 on error.
  */
-extern int32_t *split_i32(const char *str, int32_t *ar, size_t ar_size, char delim = ',');
+extern size_t json_arr_i32(const char *str, int32_t *ar, size_t ar_size, const char **endptr = nullptr);
 
 /**
- * @brief Splits a string into an array of 32-bit unsigned integers based on a delimiter.
- * @param str The input string to split.
- * @param ar The output array to store uint32_t values.
+ * @brief Reads a JSON array of 32-bit unsigned integers in one pass (see json_arr_bool()).
+ * @param str Pointer to the array in the JSON text.
+ * @param ar The output array.
  * @param ar_size The size of the output array.
- * @param delim The delimiter character (default: ',').
- * @return Pointer to the output array, or NULL on error.
+ * @param endptr Optional pointer receiving the position after `]` (or `str` on error).
+ * @return The number of elements in the JSON array, or 0 on error.
  */
-extern uint32_t *split_u32(const char *str, uint32_t *ar, size_t ar_size, char delim = ',');
+extern size_t json_arr_u32(const char *str, uint32_t *ar, size_t ar_size, const char **endptr = nullptr);
 
 /**
- * @brief Splits a string into an array of 64-bit signed integers based on a delimiter.
- * @param str The input string to split.
- * @param ar The output array to store int64_t values.
+ * @brief Reads a JSON array of 64-bit signed integers in one pass (see json_arr_bool()).
+ * @param str Pointer to the array in the JSON text.
+ * @param ar The output array.
  * @param ar_size The size of the output array.
- * @param delim The delimiter character (default: ',').
- * @return Pointer to the output array, or NULL on error.
+ * @param endptr Optional pointer receiving the position after `]` (or `str` on error).
+ * @return The number of elements in the JSON array, or 0 on error.
  */
-extern int64_t *split_i64(const char *str, int64_t *ar, size_t ar_size, char delim = ',');
+extern size_t json_arr_i64(const char *str, int64_t *ar, size_t ar_size, const char **endptr = nullptr);
 
 /**
- * @brief Splits a string into an array of 64-bit unsigned integers based on a delimiter.
- * @param str The input string to split.
- * @param ar The output array to store uint64_t values.
+ * @brief Reads a JSON array of 64-bit unsigned integers in one pass (see json_arr_bool()).
+ * @param str Pointer to the array in the JSON text.
+ * @param ar The output array.
  * @param ar_size The size of the output array.
- * @param delim The delimiter character (default: ',').
- * @return Pointer to the output array, or NULL on error.
+ * @param endptr Optional pointer receiving the position after `]` (or `str` on error).
+ * @return The number of elements in the JSON array, or 0 on error.
  */
-extern uint64_t *split_u64(const char *str, uint64_t *ar, size_t ar_size, char delim = ',');
+extern size_t json_arr_u64(const char *str, uint64_t *ar, size_t ar_size, const char **endptr = nullptr);
 
 /**
- * @brief Splits a string into an array of floats based on a delimiter.
- * @param str The input string to split.
- * @param ar The output array to store float values.
+ * @brief Reads a JSON array of floats in one pass (see json_arr_bool()).
+ * @param str Pointer to the array in the JSON text.
+ * @param ar The output array.
  * @param ar_size The size of the output array.
- * @param d The decimal separator character (e.g., '.' or ',').
- * @param delim The delimiter character (default: ',').
- * @return Pointer to the output array, or NULL on error.
+ * @param endptr Optional pointer receiving the position after `]` (or `str` on error).
+ * @return The number of elements in the JSON array, or 0 on error.
  */
-extern float *split_float(const char *str, float *ar, size_t ar_size, char d, char delim = ',');
+extern size_t json_arr_float(const char *str, float *ar, size_t ar_size, const char **endptr = nullptr);
 
 /**
- * @brief Splits a string into an array of doubles based on a delimiter.
- * @param str The input string to split.
- * @param ar The output array to store double values.
+ * @brief Reads a JSON array of doubles in one pass (see json_arr_bool()).
+ * @param str Pointer to the array in the JSON text.
+ * @param ar The output array.
  * @param ar_size The size of the output array.
- * @param d The decimal separator character (e.g., '.' or ',').
- * @param delim The delimiter character (default: ',').
- * @return Pointer to the output array, or NULL on error.
+ * @param endptr Optional pointer receiving the position after `]` (or `str` on error).
+ * @return The number of elements in the JSON array, or 0 on error.
  */
-extern double *split_double(const char *str, double *ar, size_t ar_size, char d, char delim = ',');
+extern size_t json_arr_double(const char *str, double *ar, size_t ar_size, const char **endptr = nullptr);
 
 /**
- * @brief Checks whether a given character sequence represents a valid number.
- *
- * This function examines a substring of a given C string and determines whether
- * it represents a valid number. The number can be an integer or a floating-point
- * value, and may optionally include a leading '+' or '-' sign and a decimal point.
+ * @brief Reads a JSON array of strings in one pass (see json_arr_bool()).
  *
- * No whitespace, exponential notation (e.g., '1e5'), or thousands separators are supported.
+ * Elements are not copied: `ar` receives pointers into `str` just after each opening
+ * quote and `ar_len` the raw (still escaped) length of each string.
  *
- * @param str Pointer to the character buffer to examine.
- * @param len Length of the substring to check.
+ * @param str Pointer to the array in the JSON text.
+ * @param ar The output array of string pointers.
+ * @param ar_len Optional output array of string lengths (may be NULL).
+ * @param ar_size The size of the output arrays.
+ * @param endptr Optional pointer receiving the position after `]` (or `str` on error).
+ * @return The number of elements in the JSON array, or 0 on error.
+ */
+extern size_t json_arr_str(const char *str, const char **ar, size_t *ar_len, size_t ar_size, const char **endptr = nullptr);
+
+/**
+ * @struct json_stream
+ * @brief Scan state for finding the end of a JSON value that arrives in chunks.
  *
- * @return true if the substring is a valid number, false otherwise.
+ * Zero-initialize (or call json_stream_reset()) before the first chunk. The state
+ * remembers how far the buffer has been scanned, the nesting depth and whether the
+ * scan stopped inside a string or right after a backslash.
+ */
+struct json_stream {
+  size_t pos;      ///< Number of buffer bytes already scanned.
+  uint16_t level;  ///< Current bracket nesting depth.
+  bool started;    ///< The top-level value has begun.
+  bool instr;      ///< Inside a string.
+  bool escape;     ///< The previous byte was a backslash inside a string.
+  bool error;      ///< Malformed input (unbalanced bracket or unsupported top-level value).
+};
+
+/**
+ * @brief Resets a json_stream to scan a new value from the start of the buffer.
+ * @param st The stream state.
  */
-extern bool is_number(const char *str, size_t len);
+extern void json_stream_reset(json_stream *st);
 
 /**
- * @brief Finds the end of a quoted JSON string.
+ * @brief Incrementally finds the end of the top-level JSON value in a growing buffer.
  *
- * Scans the given string starting from the first double quote (`"`) and returns
- * a pointer to the character after the closing quote. Handles escaped quotes (e.g., `\"`) correctly.
+ * Call it each time bytes are appended to `buf`; only the bytes after the previous
+ * call are scanned, so the total work is linear in the message size. The top-level
+ * value must be an array, an object or a string; leading whitespace is skipped.
+ * If the caller moves the buffer contents, the state must be reset.
  *
- * @param str Pointer to the string starting at a double quote (`"`).
- * @return Pointer to the character immediately after the closing quote, or NULL if unterminated.
+ * @param st The stream state.
+ * @param buf The buffer holding all bytes received so far (need not be null-terminated).
+ * @param len The number of valid bytes in `buf`.
+ * @return Pointer one past the end of the complete value, or NULL if more bytes are
+ *         needed or the input is malformed (`st->error` is set).
  */
-extern const char *str_end(const char *str);
+extern const char *json_stream_end(json_stream *st, const char *buf, size_t len);
 
 /**
- * @brief Skips over whitespace characters in a string.
+ * @typedef json_off_t
+ * @brief Offset type used by the JSON tape (16-bit on AVR, 32-bit elsewhere).
+ */
+#ifdef __AVR__
+typedef uint16_t json_off_t;
+#else
+typedef uint32_t json_off_t;
+#endif
+
+/**
+ * @def JSON_TAPE_MAX
+ * @brief Suggested number of tape entries for a statically allocated JSON tape.
+ */
+#ifdef __AVR__
+#define JSON_TAPE_MAX 32
+#else
+#define JSON_TAPE_MAX 512
+#endif
+
+/**
+ * @def JSON_NPOS
+ * @brief Returned by the tape lookup functions when no token matches.
+ */
+#define JSON_NPOS ((size_t)-1)
+
+/**
+ * @def JSON_SIMD_MIN
+ * @brief Input length from which the length-bounded JSON scanners use the 64-byte block stage.
+ */
+#define JSON_SIMD_MIN 256
+
+/**
+ * @brief Finds the end of a quoted JSON string within a length-bounded buffer.
  *
- * Advances the pointer past any leading whitespace characters such as space, tab,
- * carriage return, or newline.
+ * Unlike str_end(const char *), any backslash escapes the following character and
+ * the buffer does not need to be null-terminated. On non-AVR targets inputs of at
+ * least JSON_SIMD_MIN bytes are scanned 64 bytes at a time.
  *
- * @param str Pointer to the start of the string to be scanned.
- * @return Pointer to the first non-whitespace character.
+ * @param str Pointer to the buffer, at or before the opening quote.
+ * @param len Number of bytes available in `str`.
+ * @return Pointer to the character immediately after the closing quote, or NULL if unterminated.
  */
-extern const char *str_ignore(const char *str);
+extern const char *str_end(const char *str, size_t len);
 
 /**
- * @brief Finds the matching closing bracket or brace in a JSON structure.
+ * @brief Finds the matching closing bracket or brace within a length-bounded buffer.
  *
- * Traverses the string from the current position to locate the end of an array (`[]`)
- * or object (`{}`), accounting for nested structures.
+ * Brackets inside strings are ignored. On non-AVR targets inputs of at least
+ * JSON_SIMD_MIN bytes are scanned 64 bytes at a time.
  *
- * @param str Pointer to the opening bracket (`[` or `{`) in the string.
- * @return Pointer to the matching closing bracket (`]` or `}`), or NULL if not found.
+ * @param str Pointer to the buffer, at or before the opening bracket (`[` or `{`).
+ * @param len Number of bytes available in `str`.
+ * @return Pointer to the matching closing bracket (`]` or `}`), or NULL if not found or unbalanced.
  */
-extern const char *br_end(const char *str);
+extern const char *br_end(const char *str, size_t len);
 
 /**
- * @brief Finds the end of a simple JSON value by locating the next comma, brace, or bracket.
+ * @brief Finds the next comma, brace, or bracket outside strings within a length-bounded buffer.
  *
- * Useful for parsing primitive values such as numbers, booleans, or null, by identifying
- * the boundary of the value token.
+ * On non-AVR targets inputs of at least JSON_SIMD_MIN bytes are scanned 64 bytes at a time.
  *
  * @param str Pointer to the beginning of the JSON value.
+ * @param len Number of bytes available in `str`.
  * @return Pointer to the first delimiter character (`,`, `}`, or `]`) or NULL if not found.
  */
-extern const char *coma_end(const char *str);
+extern const char *coma_end(const char *str, size_t len);
+
+/**
+ * @brief Records the offsets of all structural characters of a JSON buffer.
+ *
+ * Structural characters are unescaped quotes plus `[`, `{`, `]`, `}`, `,` and `:`
+ * outside strings. On non-AVR targets the buffer is classified 64 bytes at a time
+ * using SSE2/NEON compares and a carry-less-multiply prefix XOR where available.
+ *
+ * @param str The JSON buffer (need not be null-terminated).
+ * @param len Number of bytes in `str`.
+ * @param pos The output array of offsets.
+ * @param pos_size The number of entries in `pos`.
+ * @return Number of offsets written (stops early when `pos` is full).
+ */
+extern size_t json_structurals(const char *str, size_t len, json_off_t *pos, size_t pos_size);
+
+/**
+ * @struct json_tok
+ * @brief One structural element of a JSON document recorded by json_index().
+ *
+ * `type` is `"` for strings, `0` for scalars (numbers, true, false, null), or the
+ * structural character itself (`[`, `{`, `]`, `}`, `,`). `pos` is the offset of the
+ * token in the original buffer (the opening quote for strings).
+ */
+struct json_tok {
+  char type;       ///< Token kind.
+  json_off_t pos;  ///< Offset of the first character in the source buffer.
+  union {
+    json_off_t len;    ///< Strings and scalars: length in bytes (quotes included).
+    json_off_t match;  ///< Brackets: tape index of the matching bracket.
+  };
+};
+
+/**
+ * @brief Builds a structural tape of a JSON document in a single pass.
+ *
+ * Every string, scalar, bracket, brace and comma of the first top-level value is
+ * recorded in order; colons are implied (a key is always followed by its value).
+ * Opening and closing brackets are linked to each other, so whole subtrees can be
+ * skipped in O(1). The source buffer is neither copied nor modified and must stay
+ * alive while the tape is used.
+ *
+ * @param str The JSON text (null-terminated).
+ * @param tape The output array of tokens.
+ * @param tape_size The number of entries in `tape` (e.g., JSON_TAPE_MAX).
+ * @return Number of tokens written, or 0 if the input is malformed or does not fit.
+ */
+extern size_t json_index(const char *str, json_tok *tape, size_t tape_size);
+
+/**
+ * @brief Returns the tape index of the token following the value at `i`.
+ *
+ * Arrays and objects are skipped as a whole by jumping to their matching bracket.
+ *
+ * @param tape The tape built by json_index().
+ * @param count The number of tokens returned by json_index().
+ * @param i Index of a value token.
+ * @return Index of the next token after the value, or JSON_NPOS if `i` is not on the tape.
+ */
+extern size_t json_next(const json_tok *tape, size_t count, size_t i);
+
+/**
+ * @brief Finds the value of a key in an object on the tape.
+ * @param str The JSON text the tape was built from.
+ * @param tape The tape built by json_index().
+ * @param count The number of tokens returned by json_index().
+ * @param obj Tape index of the object's `{` token (JSON_NPOS is accepted and yields JSON_NPOS).
+ * @param key The key to look for (null-terminated, compared without unescaping).
+ * @return Tape index of the value, or JSON_NPOS if the key is not present or `obj` is not an object.
+ */
+extern size_t json_key(const char *str, const json_tok *tape, size_t count, size_t obj, const char *key);
+
+/**
+ * @brief Finds the n-th element of an array on the tape.
+ * @param tape The tape built by json_index().
+ * @param count The number of tokens returned by json_index().
+ * @param arr Tape index of the array's `[` token (JSON_NPOS is accepted and yields JSON_NPOS).
+ * @param n Zero-based element index.
+ * @return Tape index of the element, or JSON_NPOS if the array is shorter or `arr` is not an array.
+ */
+extern size_t json_at(const json_tok *tape, size_t count, size_t arr, size_t n);
+
+/**
+ * @brief Returns a pointer into the source buffer for a string or scalar token.
+ *
+ * For strings the quotes are excluded and escapes are left as-is. The returned
+ * pointer is not null-terminated at `len`, but numeric tokens can be passed directly
+ * to str_to_i32(), str_to_double() and friends since they stop at the first
+ * non-numeric character.
+ *
+ * @param str The JSON text the tape was built from.
+ * @param tok The token to extract.
+ * @param len Optional pointer receiving the content length.
+ * @return Pointer to the token content, or NULL for bracket and comma tokens.
+ */
+extern const char *json_str(const char *str, const json_tok *tok, size_t *len = nullptr);
 
 #include "utils.tpp"
\ No newline at end of file
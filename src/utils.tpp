@@ -1,7 +1,291 @@
 #pragma once
+#include <string.h>
 #include "utils.h"
 
+// Unsigned type of the same width, so shifts and masks never act on a sign bit
 template <typename T>
-static T getBits(T v, uint8_t start, uint8_t count) {
-  return (v >> start) & ((1 << count) - 1);
-}
\ No newline at end of file
+struct bits_uint {
+  typedef T type;
+};
+template <>
+struct bits_uint<char> {
+  typedef unsigned char type;
+};
+template <>
+struct bits_uint<signed char> {
+  typedef unsigned char type;
+};
+template <>
+struct bits_uint<short> {
+  typedef unsigned short type;
+};
+template <>
+struct bits_uint<int> {
+  typedef unsigned int type;
+};
+template <>
+struct bits_uint<long> {
+  typedef unsigned long type;
+};
+template <>
+struct bits_uint<long long> {
+  typedef unsigned long long type;
+};
+
+template <typename T>
+static constexpr T bitMask(uint8_t count) {
+  // All-ones shifted right, so no shift reaches the width of T and no int
+  // promotion overflows
+  return count == 0 ? (T)0
+         : count >= sizeof(T) * 8
+             ? (T)~(T)0
+             : (T)((typename bits_uint<T>::type)~(typename bits_uint<T>::type)0 >> (sizeof(T) * 8 - count));
+}
+
+template <typename T>
+static constexpr T getBits(T v, uint8_t start, uint8_t count) {
+  return (T)(((typename bits_uint<T>::type)v >> start) & bitMask<typename bits_uint<T>::type>(count));
+}
+
+template <typename T>
+static constexpr T setBits(T v, uint8_t start, uint8_t count) {
+  return (T)((typename bits_uint<T>::type)v | (typename bits_uint<T>::type)(bitMask<typename bits_uint<T>::type>(count) << start));
+}
+
+template <typename T>
+static constexpr T clearBits(T v, uint8_t start, uint8_t count) {
+  return (T)((typename bits_uint<T>::type)v & (typename bits_uint<T>::type)~(typename bits_uint<T>::type)(bitMask<typename bits_uint<T>::type>(count) << start));
+}
+
+template <typename T>
+static constexpr T insertBits(T v, uint8_t start, uint8_t count, T field) {
+  return (T)((typename bits_uint<T>::type)clearBits(v, start, count) |
+             (typename bits_uint<T>::type)(((typename bits_uint<T>::type)field & bitMask<typename bits_uint<T>::type>(count)) << start));
+}
+
+template <uint8_t Start, uint8_t Count, typename T>
+static constexpr T getBits(T v) {
+  static_assert(Count > 0 && Start + Count <= sizeof(T) * 8, "bit field outside of T");
+  return getBits(v, Start, Count);
+}
+
+template <uint8_t Start, uint8_t Count, typename T>
+static constexpr T setBits(T v) {
+  static_assert(Count > 0 && Start + Count <= sizeof(T) * 8, "bit field outside of T");
+  return setBits(v, Start, Count);
+}
+
+template <uint8_t Start, uint8_t Count, typename T>
+static constexpr T clearBits(T v) {
+  static_assert(Count > 0 && Start + Count <= sizeof(T) * 8, "bit field outside of T");
+  return clearBits(v, Start, Count);
+}
+
+template <uint8_t Start, uint8_t Count, typename T>
+static constexpr T insertBits(T v, T field) {
+  static_assert(Count > 0 && Start + Count <= sizeof(T) * 8, "bit field outside of T");
+  return insertBits(v, Start, Count, field);
+}
+
+// Bit intrinsics use the compiler builtins where they map to instructions. On
+// AVR the builtins are libgcc loops, so small tables and bisection are used.
+#if defined(__GNUC__) && !defined(__AVR__)
+#define BIT_BUILTINS
+#endif
+
+static constexpr uint8_t bit_nibble_count[16] = {0, 1, 1, 2, 1, 2, 2, 3, 1, 2, 2, 3, 2, 3, 3, 4};
+
+template <typename U>
+static constexpr uint8_t bit_count_bytes(U v, uint8_t n) {
+  return n == 0 ? 0 : bit_nibble_count[v & 15] + bit_nibble_count[(v >> 4) & 15] + bit_count_bytes((U)(v >> 8), n - 1);
+}
+
+// Leading zeros of a non-zero v below 2^w, by halving w
+template <typename U>
+static constexpr uint8_t bit_clz_bisect(U v, uint8_t w) {
+  return w == 1 ? 0 : (v >> (w / 2)) ? bit_clz_bisect((U)(v >> (w / 2)), w / 2) : w / 2 + bit_clz_bisect(v, w / 2);
+}
+
+template <typename U>
+static constexpr U bit_swap_pairs(U v, uint8_t s, U m) {
+  return (U)(((v >> s) & m) | ((v & m) << s));
+}
+
+// Byte swap by shifts: the low byte moves to the top, the rest is swapped below it
+template <typename U>
+static constexpr U bit_swap_bytes(U v, uint8_t n) {
+  return n <= 1 ? v : (U)((U)(v & 0xFF) << (8 * (n - 1)) | bit_swap_bytes((U)(v >> 8), n - 1));
+}
+
+// SWAR population count: bit pairs, then nibbles, then a multiply sums the bytes
+template <typename U>
+static constexpr U bit_count_nibbles(U v) {
+  return (U)((v + (v >> 4)) & ((U)~(U)0 / 17));
+}
+
+template <typename U>
+static constexpr U bit_count_pairs(U v) {
+  return (U)((v & ((U)~(U)0 / 5)) + ((v >> 2) & ((U)~(U)0 / 5)));
+}
+
+template <typename U>
+static constexpr uint8_t bit_count_swar(U v) {
+  return (uint8_t)((U)(bit_count_nibbles(bit_count_pairs((U)(v - ((v >> 1) & ((U)~(U)0 / 3))))) * ((U)~(U)0 / 255)) >>
+                   (sizeof(U) * 8 - 8));
+}
+
+template <typename T>
+static constexpr uint8_t bitCount(T v) {
+#if defined(__POPCNT__) || defined(__aarch64__)
+  return sizeof(T) <= sizeof(unsigned) ? __builtin_popcount((typename bits_uint<T>::type)v)
+                                       : __builtin_popcountll((typename bits_uint<T>::type)v);
+#elif defined(BIT_BUILTINS)
+  // Without a popcount instruction the builtin is a libgcc call
+  return sizeof(T) <= 4 ? bit_count_swar((uint32_t)(typename bits_uint<T>::type)v)
+                        : bit_count_swar((uint64_t)(typename bits_uint<T>::type)v);
+#else
+  return bit_count_bytes((typename bits_uint<T>::type)v, sizeof(T));
+#endif
+}
+
+template <typename T>
+static constexpr uint8_t bitClz(T v) {
+#ifdef BIT_BUILTINS
+  return v == 0 ? sizeof(T) * 8
+         : sizeof(T) <= sizeof(unsigned)
+             ? __builtin_clz((typename bits_uint<T>::type)v) - (sizeof(unsigned) - sizeof(T)) * 8
+             : __builtin_clzll((typename bits_uint<T>::type)v);
+#else
+  return v == 0 ? sizeof(T) * 8 : bit_clz_bisect((typename bits_uint<T>::type)v, sizeof(T) * 8);
+#endif
+}
+
+template <typename T>
+static constexpr uint8_t bitCtz(T v) {
+#ifdef BIT_BUILTINS
+  return v == 0 ? sizeof(T) * 8
+         : sizeof(T) <= sizeof(unsigned) ? __builtin_ctz((typename bits_uint<T>::type)v)
+                                         : __builtin_ctzll((typename bits_uint<T>::type)v);
+#else
+  // The bits below the lowest set bit, counted
+  return v == 0 ? sizeof(T) * 8
+                : bitCount((typename bits_uint<T>::type)(((typename bits_uint<T>::type)v & (typename bits_uint<T>::type)(0 - (typename bits_uint<T>::type)v)) - 1));
+#endif
+}
+
+template <typename T>
+static constexpr T bitRotl(T v, uint8_t n) {
+  return n % (sizeof(T) * 8) == 0 ? v
+                                  : (T)((typename bits_uint<T>::type)((typename bits_uint<T>::type)v << (n % (sizeof(T) * 8))) |
+                                        (typename bits_uint<T>::type)((typename bits_uint<T>::type)v >> (sizeof(T) * 8 - n % (sizeof(T) * 8))));
+}
+
+template <typename T>
+static constexpr T bitRotr(T v, uint8_t n) {
+  return bitRotl(v, (uint8_t)(sizeof(T) * 8 - n % (sizeof(T) * 8)));
+}
+
+template <typename T>
+static constexpr T byteSwap(T v) {
+#ifdef BIT_BUILTINS
+  return sizeof(T) == 1 ? v
+         : sizeof(T) == 2 ? (T)__builtin_bswap16((uint16_t)v)
+         : sizeof(T) == 4 ? (T)__builtin_bswap32((uint32_t)v)
+                          : (T)__builtin_bswap64((uint64_t)v);
+#else
+  return (T)bit_swap_bytes((typename bits_uint<T>::type)v, sizeof(T));
+#endif
+}
+
+template <typename T>
+static constexpr T bitReverse(T v) {
+  // Swap adjacent bits, pairs and nibbles, then the bytes
+  return byteSwap((T)bit_swap_pairs(
+      bit_swap_pairs(bit_swap_pairs((typename bits_uint<T>::type)v, 1, (typename bits_uint<T>::type)((typename bits_uint<T>::type)~(typename bits_uint<T>::type)0 / 3)),
+                     2, (typename bits_uint<T>::type)((typename bits_uint<T>::type)~(typename bits_uint<T>::type)0 / 5)),
+      4, (typename bits_uint<T>::type)((typename bits_uint<T>::type)~(typename bits_uint<T>::type)0 / 17)));
+}
+
+// Unaligned loads and stores through memcpy compile to single moves; the swap
+// is only applied when the wire order differs from the target's
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define ENDIAN_BE_SWAP(v) byteSwap(v)
+#define ENDIAN_LE_SWAP(v) (v)
+#else
+#define ENDIAN_BE_SWAP(v) (v)
+#define ENDIAN_LE_SWAP(v) byteSwap(v)
+#endif
+
+template <typename U>
+static inline U endian_load(const uint8_t *p) {
+  U v;
+  memcpy(&v, p, sizeof(v));
+  return v;
+}
+
+template <typename U>
+static inline void endian_store(uint8_t *p, U v) {
+  memcpy(p, &v, sizeof(v));
+}
+
+static inline uint16_t load_be16(const uint8_t *p) { return ENDIAN_BE_SWAP(endian_load<uint16_t>(p)); }
+static inline uint32_t load_be32(const uint8_t *p) { return ENDIAN_BE_SWAP(endian_load<uint32_t>(p)); }
+static inline uint64_t load_be64(const uint8_t *p) { return ENDIAN_BE_SWAP(endian_load<uint64_t>(p)); }
+static inline uint16_t load_le16(const uint8_t *p) { return ENDIAN_LE_SWAP(endian_load<uint16_t>(p)); }
+static inline uint32_t load_le32(const uint8_t *p) { return ENDIAN_LE_SWAP(endian_load<uint32_t>(p)); }
+static inline uint64_t load_le64(const uint8_t *p) { return ENDIAN_LE_SWAP(endian_load<uint64_t>(p)); }
+
+static inline void store_be16(uint8_t *p, uint16_t v) { endian_store(p, ENDIAN_BE_SWAP(v)); }
+static inline void store_be32(uint8_t *p, uint32_t v) { endian_store(p, ENDIAN_BE_SWAP(v)); }
+static inline void store_be64(uint8_t *p, uint64_t v) { endian_store(p, ENDIAN_BE_SWAP(v)); }
+static inline void store_le16(uint8_t *p, uint16_t v) { endian_store(p, ENDIAN_LE_SWAP(v)); }
+static inline void store_le32(uint8_t *p, uint32_t v) { endian_store(p, ENDIAN_LE_SWAP(v)); }
+static inline void store_le64(uint8_t *p, uint64_t v) { endian_store(p, ENDIAN_LE_SWAP(v)); }
+
+template <typename F, typename U>
+static inline F endian_bits_to(U v) {
+  F f = 0;
+  memcpy(&f, &v, sizeof(F) < sizeof(U) ? sizeof(F) : sizeof(U));
+  return f;
+}
+
+template <typename U, typename F>
+static inline U endian_bits_of(F f) {
+  U v = 0;
+  memcpy(&v, &f, sizeof(F) < sizeof(U) ? sizeof(F) : sizeof(U));
+  return v;
+}
+
+static inline float load_be_float(const uint8_t *p) { return endian_bits_to<float>(load_be32(p)); }
+static inline float load_le_float(const uint8_t *p) { return endian_bits_to<float>(load_le32(p)); }
+static inline void store_be_float(uint8_t *p, float v) { store_be32(p, endian_bits_of<uint32_t>(v)); }
+static inline void store_le_float(uint8_t *p, float v) { store_le32(p, endian_bits_of<uint32_t>(v)); }
+
+// On AVR double is 32 bits wide, so these use the 32-bit forms there
+static inline double load_be_double(const uint8_t *p) {
+  return sizeof(double) == 8 ? endian_bits_to<double>(load_be64(p)) : endian_bits_to<double>(load_be32(p));
+}
+static inline double load_le_double(const uint8_t *p) {
+  return sizeof(double) == 8 ? endian_bits_to<double>(load_le64(p)) : endian_bits_to<double>(load_le32(p));
+}
+static inline void store_be_double(uint8_t *p, double v) {
+  if (sizeof(double) == 8) {
+    store_be64(p, endian_bits_of<uint64_t>(v));
+  } else {
+    store_be32(p, endian_bits_of<uint32_t>(v));
+  }
+}
+static inline void store_le_double(uint8_t *p, double v) {
+  if (sizeof(double) == 8) {
+    store_le64(p, endian_bits_of<uint64_t>(v));
+  } else {
+    store_le32(p, endian_bits_of<uint32_t>(v));
+  }
+}
+
+// Zigzag maps signed values to unsigned ones with small magnitudes first:
+// 0, -1, 1, -2, ... become 0, 1, 2, 3, ...
+static constexpr uint32_t zigzag32(int32_t v) { return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31); }
+static constexpr uint64_t zigzag64(int64_t v) { return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63); }
+static constexpr int32_t unzigzag32(uint32_t v) { return (int32_t)((v >> 1) ^ (0 - (v & 1))); }
+static constexpr int64_t unzigzag64(uint64_t v) { return (int64_t)((v >> 1) ^ (0 - (v & 1))); }